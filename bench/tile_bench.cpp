@@ -0,0 +1,172 @@
+// Micro-benchmarks for raytmx's tile layer decoders, built apart from the game with 'make bench'.
+// Each bench writes a generated map to a temporary TMX document and times LoadTMX() on it with the SIMD decoders
+// enabled and disabled (SetSIMDDecodingTMX()), checking the loaded tiles against the generated ones. LoadTMX() times
+// include parsing the rest of the document, which is small next to the tile layer.
+//
+// tile_bench [--csv] [--base64] [--tiles N] [--iterations N]
+#include <raylib.h>
+#define RAYTMX_IMPLEMENTATION
+#include "../raytmx.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+const char *BENCH_MAP_FILE = "tile_bench.tmx";
+
+// Generate 'count' random GIDs referencing the tileset written by writeBenchMap()
+std::vector<uint32_t> generateGids(uint32_t count)
+{
+    std::vector<uint32_t> gids(count);
+    for (uint32_t &gid : gids) {
+        gid = (uint32_t)GetRandomValue(0, 72);
+    }
+    return gids;
+}
+
+// Write a map of one side x side tile layer whose <data> holds 'data' in the given encoding
+bool writeBenchMap(int side, const char *encoding, const std::string &data)
+{
+    FILE *file = fopen(BENCH_MAP_FILE, "wb");
+    if (file == nullptr) {
+        fprintf(stderr, "Unable to write %s\n", BENCH_MAP_FILE);
+        return false;
+    }
+    fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<map version=\"1.10\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"%d\" height=\"%d\" "
+        "tilewidth=\"16\" tileheight=\"16\" infinite=\"0\" nextlayerid=\"2\" nextobjectid=\"1\">\n"
+        " <tileset firstgid=\"1\" name=\"bench\" tilewidth=\"16\" tileheight=\"16\" tilecount=\"72\" columns=\"72\">\n"
+        "  <image source=\"bench.png\" width=\"1152\" height=\"16\"/>\n"
+        " </tileset>\n"
+        " <layer id=\"1\" name=\"bench\" width=\"%d\" height=\"%d\">\n"
+        "  <data encoding=\"%s\">", side, side, side, side, encoding);
+    fwrite(data.data(), 1, data.size(), file);
+    fprintf(file, "</data>\n </layer>\n</map>\n");
+    return fclose(file) == 0;
+}
+
+// Time loading the bench map, keeping the best of 'iterations', and compare its tiles against 'gids'
+bool benchLoad(const char *name, bool useSIMD, const std::vector<uint32_t> &gids, size_t dataBytes, int iterations)
+{
+    SetSIMDDecodingTMX(useSIMD);
+    double best = 1e30;
+    bool match = true;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        auto start = std::chrono::steady_clock::now();
+        TmxMap *map = LoadTMX(BENCH_MAP_FILE);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        if (map == nullptr || map->layersLength != 1) {
+            match = false;
+        } else {
+            const TmxTileLayer &layer = map->layers[0].exact.tileLayer;
+            match = match && layer.tilesLength == gids.size() &&
+                std::equal(gids.begin(), gids.end(), layer.tiles);
+        }
+        UnloadTMX(map);
+    }
+    SetSIMDDecodingTMX(true);
+    printf("%-8s %8.3f ms  %7.1f MB/s  %s\n", name, best * 1000.0, dataBytes / best / 1e6, match ? "ok" : "MISMATCH");
+    return match;
+}
+
+// Time loading a map with a generated side x side CSV tile layer, laid out the way Tiled writes it
+bool RunCsvBench(int side, int iterations)
+{
+    uint32_t count = (uint32_t)side * side;
+    std::vector<uint32_t> gids = generateGids(count);
+    std::string csv = "\n";
+    for (uint32_t i = 0; i < count; i++) {
+        csv += std::to_string(gids[i]);
+        csv += i + 1 < count ? "," : "";
+        if ((i + 1) % side == 0) {
+            csv += "\n";
+        }
+    }
+    if (!writeBenchMap(side, "csv", csv)) {
+        return false;
+    }
+
+    printf("CSV: %dx%d tiles, %zu bytes, best of %d\n", side, side, csv.size(), iterations);
+    bool ok = benchLoad("scalar", false, gids, csv.size(), iterations);
+    ok = benchLoad("simd", true, gids, csv.size(), iterations) && ok;
+    remove(BENCH_MAP_FILE);
+    return ok;
+}
+
+// Time loading a map with a generated, uncompressed side x side Base64 tile layer. raylib's DecodeDataBase64, which
+// raytmx used before it had its own decoder, is timed alone on the same data for reference.
+bool RunBase64Bench(int side, int iterations)
+{
+    uint32_t count = (uint32_t)side * side;
+    std::vector<uint32_t> gids = generateGids(count);
+    int encodedLength = 0;
+    char *encoded = EncodeDataBase64((const unsigned char *)gids.data(), (int)(count * sizeof(uint32_t)),
+        &encodedLength);
+    std::string base64 = encoded;
+    MemFree(encoded);
+    if (!writeBenchMap(side, "base64", "\n   " + base64 + "\n  ")) {
+        return false;
+    }
+
+    printf("Base64: %dx%d tiles, %zu bytes, best of %d\n", side, side, base64.size(), iterations);
+    double best = 1e30;
+    bool ok = true;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        int decodedLength = 0;
+        auto start = std::chrono::steady_clock::now();
+        unsigned char *decoded = DecodeDataBase64((const unsigned char *)base64.c_str(), &decodedLength);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        ok = ok && decodedLength == (int)(count * sizeof(uint32_t)) &&
+            std::equal(gids.begin(), gids.end(), (const uint32_t *)decoded);
+        MemFree(decoded);
+    }
+    printf("%-8s %8.3f ms  %7.1f MB/s  %s\n", "raylib", best * 1000.0, base64.size() / best / 1e6,
+        ok ? "ok" : "MISMATCH");
+    ok = benchLoad("scalar", false, gids, base64.size(), iterations) && ok;
+    ok = benchLoad("simd", true, gids, base64.size(), iterations) && ok;
+    remove(BENCH_MAP_FILE);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    bool runCsv = false;
+    bool runBase64 = false;
+    int tiles = 1000;
+    int iterations = 20;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--csv") {
+            runCsv = true;
+        } else if (arg == "--base64") {
+            runBase64 = true;
+        } else if (arg == "--tiles" && hasValue) {
+            tiles = atoi(argv[++i]);
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    if (tiles <= 0 || iterations <= 0) {
+        fprintf(stderr, "--tiles and --iterations must be positive\n");
+        return EXIT_FAILURE;
+    }
+    if (!runCsv && !runBase64) {
+        runCsv = runBase64 = true; // No bench picked: run them all
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetTextureLoadingTMX(false);
+    bool ok = true;
+    if (runCsv) {
+        ok = RunCsvBench(tiles, iterations) && ok;
+    }
+    if (runBase64) {
+        ok = RunBase64Bench(tiles, iterations) && ok;
+    }
+    return ok ? 0 : EXIT_FAILURE;
+}
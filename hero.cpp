@@ -8,6 +8,11 @@
 #include "raytmx.h"
 #include <string>
 #include <unordered_set>
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <cstdio>
+#include <future>
 
 // Sound effect and music variables
 Music menuMusic;
@@ -29,10 +34,13 @@ const float MAX_GRAV = 300.0f;
 const float JUMP_FORCE = -250.0f;
 const float MAX_JUMP_HOLD = 0.5f;
 const float JUMP_BOOST = -350.0f;
+const float SIM_DT = 1.0f / 120.0f;     // Fixed simulation step (120 Hz)
+const float MAX_FRAME_TIME = 0.25f;     // Longest frame the simulation will try to catch up on
 
 // Game states
 enum GameState {
     MENU,
+    LOADING,    // Waiting on the selected map's background load
     GAMEPLAY,
     GAME_OVER,
     WIN_SCREEN
@@ -78,32 +86,77 @@ enum AnimationType
     ONESHOT
 };
 
-//Animation values
-struct Animation
+//Animation clip values, shared by every entity playing the clip
+struct AnimationClip
 {
     int fst;
     int lst;
-    int cur;
     int offset;
     int width;
     int height;
     float spd;
-    float rem;
     AnimationType type;
 };
 
+//Every clip in the game
+enum AnimationClipId
+{
+    CLIP_HERO_DEAD,
+    CLIP_HERO_RUN,
+    CLIP_HERO_IDLE,
+    CLIP_HERO_ROLL,
+    CLIP_HERO_JUMP,
+    CLIP_HERO_FALL,
+    CLIP_HERO_HIT,
+    CLIP_FLY_EYE,
+    CLIP_COUNT
+};
+
+const AnimationClip ANIMATION_CLIPS[CLIP_COUNT] = {
+    {0, 7, 0, 16, 16, 0.1f, ONESHOT},    // CLIP_HERO_DEAD
+    {0, 5, 1, 16, 16, 0.1f, REPEATING},  // CLIP_HERO_RUN
+    {0, 3, 5, 16, 16, 0.1f, REPEATING},  // CLIP_HERO_IDLE
+    {0, 2, 9, 16, 16, 0.1f, REPEATING},  // CLIP_HERO_ROLL
+    {0, 2, 7, 16, 16, 0.1f, REPEATING},  // CLIP_HERO_JUMP
+    {0, 2, 6, 16, 16, 0.1f, REPEATING},  // CLIP_HERO_FALL
+    {0, 3, 8, 16, 16, 0.1f, REPEATING},  // CLIP_HERO_HIT
+    {0, 4, 0, 48, 48, 0.1f, REPEATING},  // CLIP_FLY_EYE
+};
+
+//Clip played for each player state (indexed by CurrentState)
+const AnimationClipId PLAYER_STATE_CLIPS[] = {
+    CLIP_HERO_DEAD, CLIP_HERO_RUN, CLIP_HERO_IDLE, CLIP_HERO_ROLL, CLIP_HERO_JUMP, CLIP_HERO_FALL, CLIP_HERO_HIT
+};
+
+//Animation values: where one entity is in its current clip
+struct Animation
+{
+    int clip;
+    int cur;
+    float rem;
+};
+
+//Where an image ended up in the texture atlas. Images that weren't packed keep a texture of their own and
+//their region covers all of it.
+struct AtlasSprite
+{
+    Texture2D texture;
+    Rectangle region;
+};
+
 //player values
 struct Player
 {
     Rectangle rect;
+    Rectangle prevRect;  // rect at the start of the last sim step, for interpolated drawing
     Rectangle hitbox;
     Vector2 vel;
     Vector2 knockbackVel;  // Knockback velocity
     float knockbackTime;   // Duration of knockback
-    Texture2D sprite;
+    AtlasSprite sprite;
     Direction dir;
     CurrentState state;
-    std::vector<Animation> animations;
+    Animation anim;
     bool isJumping;
     float jumpTime;
     int health;
@@ -117,18 +170,27 @@ struct Score_Orb {
     float score = 1;
     Color color;
     bool collected;
+    int gridId;
 };
 
-//Enemy values
-struct Enemy
+//Enemy values, stored as parallel arrays: enemy i lives at index i of every array.
+//Size, hitbox inset and sprite are the same for every enemy and kept out of the per-enemy data.
+const float ENEMY_SIZE = 64.0f;
+const float ENEMY_HITBOX_SIZE = 48.0f;
+const float ENEMY_HITBOX_OFFSET = 12.0f;
+
+struct EnemyPool
 {
-    Rectangle rect;
-    Rectangle hitbox;
-    Vector2 vel;
-    Texture2D sprite;
-    Direction dir;
-    EnemyState e_state;
-    std::vector<Animation> animations;
+    std::vector<float> x, y;          // Sprite rect position
+    std::vector<float> prevX, prevY;  // Position at the start of the last sim step
+    std::vector<float> velX, velY;    // Zero for enemies that aren't E_MOVING
+    std::vector<float> hitX, hitY;    // Hitbox position
+    std::vector<Direction> dir;
+    std::vector<EnemyState> e_state;
+    std::vector<Animation> anim;
+    std::vector<int> gridId;
+
+    size_t size() const { return x.size(); }
 };
 
 //spike obstacle values
@@ -140,17 +202,19 @@ struct Spike {
     float endY;    // Controls spike movement up/down
     bool rising;  
     bool moving;
-    Texture2D texture;    // Whether the spike is moving up
+    AtlasSprite sprite;
+    int gridId;
 };
 
 //falling platform values
 struct fallingPlat{
     Rectangle rect;
+    Rectangle prevRect;
     Rectangle Pos;
     Vector2 vel;
-    Texture2D text;
     bool isFalling;
     float timer;
+    int gridId;
 };
 
 //Death transition values
@@ -161,33 +225,705 @@ struct DeathTransition {
     const float duration = 1.0f; // 1 second transition
 };
 
-std::vector <Enemy> enemies; // Store enemies in a vector
+//Draw layers for the sprite batch, lowest drawn first. Within a layer sprites are grouped by texture,
+//so anything that has to overlap in a fixed order needs its own layer.
+enum SpriteLayer
+{
+    SPRITE_LAYER_WORLD,   // Spikes, falling and solid platforms
+    SPRITE_LAYER_ACTORS   // Player and enemies
+};
+
+//One textured quad queued for the sprite batch
+struct SpriteQuad
+{
+    Texture2D texture;
+    Rectangle source;
+    Rectangle dest;
+    Color tint;
+    int layer;
+    int order;  // Submission order, keeps sorting stable
+};
+
+//Quads collected over a frame and submitted sorted by layer, then texture
+struct SpriteBatch
+{
+    std::vector<SpriteQuad> quads;
+    int textureSwitches;  // Texture changes during this frame's flushes, roughly the number of draw calls they cost
+    int quadsDrawn;       // Quads drawn by this frame's flushes, both reset every frame
+};
+
+//Entities submitted vs skipped for being off camera, reset every frame
+struct CullStats
+{
+    int drawn;
+    int culled;
+};
+
+//Input sampled once per rendered frame. Pressed/released edges are latched until a sim step consumes them,
+//so a key tap is never lost on frames that run no step or counted twice on frames that run several.
+struct SimInput {
+    bool left;
+    bool right;
+    bool jumpDown;
+    bool jumpPressed;
+    bool jumpReleased;
+};
+
+//Everything a fixed simulation step works on, besides the global entity vectors
+struct SimState {
+    float dt;                    // Length of one step (SIM_DT)
+    double time;                 // Simulated seconds, drives invulnerability timing
+    float accumulator;           // Frame time not yet simulated, carried over to the next frame
+    SimInput input;
+    TmxMap *map;
+    Player *player;
+    Camera2D *camera;
+    Vector2 prevCameraTarget;    // Camera target at the start of the last step
+    std::vector<Score_Orb> *orbs;
+    DeathTransition *transition;
+    float enemySpawnTimer;
+    float enemySpawnInterval;
+};
+
+//Static collision index, built once per map load from the "collisions" layer
+struct CollisionIndex {
+    std::vector<Rectangle> boxes;      // Flat array of platform AABBs
+    std::vector<TmxObject*> objects;   // Source TMX object of each box
+    std::vector<int> cellStart;        // Where each cell's run begins in cellItems (cols * rows + 1 entries)
+    std::vector<int> cellItems;        // Box indices grouped by cell
+    std::vector<unsigned int> stamps;  // Last query that returned each box, to skip boxes spanning several cells
+    unsigned int queryStamp;
+    float originX;
+    float originY;
+    float cellSize;
+    int cols;
+    int rows;
+};
+
+//Kinds of dynamic entities registered in the entity grid
+enum EntityKind
+{
+    ENT_ENEMY,
+    ENT_ORB,
+    ENT_SPIKE,
+    ENT_FALLING_PLAT
+};
+
+//Spatial hash of moving/spawned entities. Items are referred to by id and remember
+//which entity (kind + index into its vector) they belong to.
+struct GridItem {
+    Rectangle rect;
+    EntityKind kind;
+    int owner;
+    int cx0, cy0, cx1, cy1;  // Cells currently covered
+    bool alive;
+};
+
+struct SpatialHashGrid {
+    float cellSize;
+    std::vector<GridItem> items;
+    std::vector<int> freeIds;
+    std::unordered_map<long long, std::vector<int>> cells;
+    std::vector<unsigned int> stamps;  // Same de-duplication trick as CollisionIndex
+    unsigned int queryStamp;
+};
+
+EnemyPool enemies;
 std::vector<Spike> spikes;
 std::vector<fallingPlat> falling_Plat;
-std::vector<Rectangle> platforms;
+
+// The level being played. Its map and starting layout stay resident across restarts; only switching to another map
+// loads anything.
+struct Level {
+    const char *mapFile;                     // File 'map' was loaded from
+    TmxMap *map;
+    std::vector<Spike> spikes;               // As every run starts with them, not yet in the entity grid
+    std::vector<fallingPlat> fallingPlats;
+};
+
+Level level = {};
+
+// A map being loaded in the background: LoadTMXDeferred() parses it and decodes its images on a worker thread, then
+// UpdateMapLoad() uploads its textures on the main thread a few per frame
+struct MapLoad {
+    std::future<TmxMap*> worker;  // Valid until the worker's map has been taken
+    TmxMap *map;                  // Taken from 'worker', uploading textures
+    uint32_t texturesTotal;
+    uint32_t texturesLeft;
+};
+
+std::unordered_map<std::string, MapLoad> mapLoads;  // Keyed by map file
+const uint32_t TEXTURE_UPLOAD_BUDGET = 1;           // Textures uploaded per frame while a map loads
+CollisionIndex collisionIndex;
+static std::vector<int> collisionCandidates; // Scratch buffer reused by every index query
 static std::unordered_set<TmxObject*> spawnedPlatforms;
+SpatialHashGrid entityGrid = { 128.0f };
+static std::vector<int> entityCandidates; // Scratch buffer reused by every grid query
+int maxEnemies = 20; // Overridden per map by its "maxEnemies" property
+bool headless = false; // No window, GPU or audio device: nothing may be drawn or loaded to the GPU
+
+double timer = 0.0;       // Sim time of the last invulnerability check
+double finishTime = 1.0;  // Sim time invulnerability wears off
+
+// Asset lifetimes. Everything acquired under a scope is released together when the scope ends.
+enum AssetScope
+{
+    SCOPE_SESSION,  // Until the game exits
+    SCOPE_LEVEL,    // Until a different level is loaded
+    SCOPE_COUNT
+};
+
+template <typename T>
+struct CachedAsset
+{
+    T asset;
+    int refs;
+    size_t bytes;
+};
+
+// Reference-counted textures and sounds keyed by file path. Loading the same path twice hands back the same
+// asset; it's unloaded once every reference to it has been released.
+struct AssetCache
+{
+    std::unordered_map<std::string, CachedAsset<Texture2D>> textures;
+    std::unordered_map<std::string, CachedAsset<Sound>> sounds;
+    std::vector<std::string> scopeTextures[SCOPE_COUNT];  // One entry per reference taken under the scope
+    std::vector<std::string> scopeSounds[SCOPE_COUNT];
+    size_t textureBytes;
+    size_t soundBytes;
+};
+
+AssetCache assets = {};
+
+Texture2D AcquireTexture(const char *path, AssetScope scope)
+{
+    auto it = assets.textures.find(path);
+    if (it == assets.textures.end()) {
+        // Headless runs have no GPU, they get a zero texture that is never drawn
+        Texture2D texture = headless ? Texture2D{} : LoadTexture(path);
+        size_t bytes = texture.id != 0 ? (size_t)GetPixelDataSize(texture.width, texture.height, texture.format) : 0;
+        it = assets.textures.emplace(path, CachedAsset<Texture2D>{ texture, 0, bytes }).first;
+        assets.textureBytes += bytes;
+    }
+    it->second.refs++;
+    assets.scopeTextures[scope].push_back(path);
+    return it->second.asset;
+}
+
+Sound AcquireSound(const char *path, AssetScope scope)
+{
+    auto it = assets.sounds.find(path);
+    if (it == assets.sounds.end()) {
+        Sound sound = headless ? Sound{} : LoadSound(path);
+        size_t bytes = (size_t)sound.frameCount * sound.stream.channels * (sound.stream.sampleSize / 8);
+        it = assets.sounds.emplace(path, CachedAsset<Sound>{ sound, 0, bytes }).first;
+        assets.soundBytes += bytes;
+    }
+    it->second.refs++;
+    assets.scopeSounds[scope].push_back(path);
+    return it->second.asset;
+}
+
+void ReleaseTexture(const std::string &path)
+{
+    auto it = assets.textures.find(path);
+    if (it == assets.textures.end() || --it->second.refs > 0) {
+        return;
+    }
+    if (it->second.asset.id != 0) {
+        UnloadTexture(it->second.asset);
+    }
+    assets.textureBytes -= it->second.bytes;
+    assets.textures.erase(it);
+}
+
+void ReleaseSound(const std::string &path)
+{
+    auto it = assets.sounds.find(path);
+    if (it == assets.sounds.end() || --it->second.refs > 0) {
+        return;
+    }
+    if (it->second.asset.frameCount != 0) {
+        UnloadSound(it->second.asset);
+    }
+    assets.soundBytes -= it->second.bytes;
+    assets.sounds.erase(it);
+}
+
+// Drop every reference taken under 'scope'
+void ReleaseAssetScope(AssetScope scope)
+{
+    for (const std::string &path : assets.scopeTextures[scope]) {
+        ReleaseTexture(path);
+    }
+    for (const std::string &path : assets.scopeSounds[scope]) {
+        ReleaseSound(path);
+    }
+    assets.scopeTextures[scope].clear();
+    assets.scopeSounds[scope].clear();
+}
+
+void TraceLogAssets(int logLevel)
+{
+    TraceLog(logLevel, "Assets: %d textures (%zu KB), %d sounds (%zu KB) resident", (int)assets.textures.size(),
+        assets.textureBytes / 1024, (int)assets.sounds.size(), assets.soundBytes / 1024);
+}
+
+// Every sprite and tileset image the game draws. They're packed into as few textures as possible at startup so
+// that a frame binds about one texture instead of one per entity type.
+const char *ATLAS_IMAGES[] = {
+    "assets/herochar-sprites/herochar_spritesheet.png",
+    "assets/herochar-sprites/fly-eye.png",
+    "assets/tiles-and-background-foreground/spike.png",
+    "assets/tiles-and-background-foreground/floor.png",
+    "assets/tiles-and-background-foreground/falling.png",
+    "assets/tiles-and-background-foreground/tileset.png",  // floor.tsx, shared by every map
+};
+const int ATLAS_PAGE_SIZE = 2048;  // Largest texture we can count on everywhere raylib runs
+const int ATLAS_PADDING = 2;       // Transparent gap so neighbouring images never bleed into each other
+
+struct TextureAtlas
+{
+    std::vector<Texture2D> pages;
+    std::unordered_map<std::string, AtlasSprite> sprites;  // Keyed by file path
+    size_t bytes;
+};
+
+TextureAtlas atlas = {};
+
+// Shelf-pack the images into atlas pages: tallest first, left to right along a shelf, starting a new shelf under
+// the current one when a row fills up and a new page when the shelves do.
+void BuildTextureAtlas(TextureAtlas *atlas, const char *const *paths, int count)
+{
+    struct Placement
+    {
+        std::string path;
+        Image image;
+        int page, x, y;
+    };
+    std::vector<Placement> placements;
+    for (int i = 0; i < count; i++) {
+        Image image = LoadImage(paths[i]);
+        if (image.data == nullptr) {
+            TraceLog(LOG_WARNING, "Atlas: couldn't load %s, it will get a texture of its own", paths[i]);
+            continue;
+        }
+        if (image.width > ATLAS_PAGE_SIZE || image.height > ATLAS_PAGE_SIZE) {
+            TraceLog(LOG_WARNING, "Atlas: %s doesn't fit on a page, it will get a texture of its own", paths[i]);
+            UnloadImage(image);
+            continue;
+        }
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        placements.push_back({ paths[i], image, 0, 0, 0 });
+    }
+    std::sort(placements.begin(), placements.end(), [](const Placement &a, const Placement &b) {
+        if (a.image.height != b.image.height) return a.image.height > b.image.height;
+        return a.image.width > b.image.width;
+    });
+
+    // Pages are trimmed to the area actually used
+    std::vector<int> pageWidths, pageHeights;
+    int page = 0, x = 0, y = 0, shelfHeight = 0;
+    for (Placement &placement : placements) {
+        if (x + placement.image.width > ATLAS_PAGE_SIZE) {
+            x = 0;
+            y += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        if (y + placement.image.height > ATLAS_PAGE_SIZE) {
+            page++;
+            x = y = shelfHeight = 0;
+        }
+        placement.page = page;
+        placement.x = x;
+        placement.y = y;
+        x += placement.image.width + ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, placement.image.height);
+
+        pageWidths.resize(page + 1, 0);
+        pageHeights.resize(page + 1, 0);
+        pageWidths[page] = std::max(pageWidths[page], placement.x + placement.image.width);
+        pageHeights[page] = std::max(pageHeights[page], placement.y + placement.image.height);
+    }
+
+    for (size_t i = 0; i < pageWidths.size(); i++) {
+        Image pageImage = GenImageColor(pageWidths[i], pageHeights[i], BLANK);
+        for (const Placement &placement : placements) {
+            if (placement.page != (int)i) {
+                continue;
+            }
+            // Copy rows as-is, ImageDraw would alpha-blend them against the blank page
+            for (int row = 0; row < placement.image.height; row++) {
+                memcpy((unsigned char *)pageImage.data + ((size_t)(placement.y + row) * pageImage.width + placement.x) * 4,
+                    (unsigned char *)placement.image.data + (size_t)row * placement.image.width * 4,
+                    (size_t)placement.image.width * 4);
+            }
+        }
+        Texture2D texture = LoadTextureFromImage(pageImage);
+        UnloadImage(pageImage);
+        atlas->pages.push_back(texture);
+        atlas->bytes += (size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+    }
+
+    for (Placement &placement : placements) {
+        Rectangle region = { (float)placement.x, (float)placement.y, (float)placement.image.width, (float)placement.image.height };
+        atlas->sprites[placement.path] = { atlas->pages[placement.page], region };
+        UnloadImage(placement.image);
+    }
+    TraceLog(LOG_INFO, "Atlas: packed %d images into %d page(s) (%zu KB)", (int)atlas->sprites.size(),
+        (int)atlas->pages.size(), atlas->bytes / 1024);
+}
+
+void UnloadTextureAtlas(TextureAtlas *atlas)
+{
+    for (Texture2D &page : atlas->pages) {
+        UnloadTexture(page);
+    }
+    atlas->pages.clear();
+    atlas->sprites.clear();
+    atlas->bytes = 0;
+}
+
+// Find an image in the atlas. Anything that wasn't packed, including everything in headless runs (which never
+// build an atlas), falls back to a texture of its own.
+AtlasSprite AcquireSprite(const char *path, AssetScope scope)
+{
+    auto it = atlas.sprites.find(path);
+    if (it != atlas.sprites.end()) {
+        return it->second;
+    }
+    Texture2D texture = AcquireTexture(path, scope);
+    return { texture, { 0, 0, (float)texture.width, (float)texture.height } };
+}
+
+// Move a source rect given relative to the original image into the sprite's atlas region.
+// Flipped (negative width) rects keep working, raylib flips around the rect and not its origin.
+Rectangle atlasSource(const AtlasSprite *sprite, Rectangle source)
+{
+    return { sprite->region.x + source.x, sprite->region.y + source.y, source.width, source.height };
+}
+
+// Point the map's tiles at the atlas copy of their tileset image, so tile layers and sprites draw from the same
+// texture. Tileset image paths are relative to the tileset file, which for every shipped map is floor.tsx in the
+// working directory.
+void RemapTilesToAtlas(TmxMap *map, const TextureAtlas *atlas)
+{
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        const TmxTileset &tileset = map->tilesets[i];
+        if (!tileset.hasImage || tileset.image.source == nullptr) {
+            continue;
+        }
+        auto it = atlas->sprites.find(tileset.image.source);
+        if (it == atlas->sprites.end()) {
+            continue;
+        }
+        for (uint32_t gid = tileset.firstGid; gid <= tileset.lastGid && gid < map->gidsToTilesLength; gid++) {
+            // Animated tiles draw through the GIDs of their frames, which get remapped themselves
+            TmxTile &tile = map->gidsToTiles[gid];
+            if (tile.gid == 0 || tile.hasAnimation || tile.texture.id != tileset.image.texture.id) {
+                continue;
+            }
+            tile.texture = it->second.texture;
+            tile.sourceRect.x += it->second.region.x;
+            tile.sourceRect.y += it->second.region.y;
+        }
+    }
+}
+
+// Read an integer map property, falling back to 'fallback' when the map doesn't set it
+int GetMapIntProperty(const TmxMap *map, const char *name, int fallback)
+{
+    for (uint32_t i = 0; i < map->propertiesLength; i++) {
+        if (map->properties[i].type == PROPERTY_TYPE_INT && strcmp(map->properties[i].name, name) == 0) {
+            return map->properties[i].intValue;
+        }
+    }
+    return fallback;
+}
+
+// Collect every "collisions" object into a flat array and bucket it into a uniform grid.
+// Only needs to run once after LoadTMX, the platforms never move.
+void BuildCollisionIndex(TmxMap *map, CollisionIndex *index, float cellSize = 128.0f)
+{
+    index->boxes.clear();
+    index->objects.clear();
+    index->cellStart.clear();
+    index->cellItems.clear();
+    index->queryStamp = 0;
+    index->cellSize = cellSize;
+    index->originX = index->originY = 0.0f;
+    index->cols = index->rows = 0;
+
+    for (unsigned int i = 0; i < map->layersLength; i++) {
+        if (strcmp(map->layers[i].name, "collisions") == 0 && map->layers[i].type == LAYER_TYPE_OBJECT_GROUP) {
+            TmxObjectGroup &objectGroup = map->layers[i].exact.objectGroup;
+            for (unsigned int j = 0; j < objectGroup.objectsLength; j++) {
+                TmxObject &col = objectGroup.objects[j];
+                index->boxes.push_back({ col.aabb.x, col.aabb.y, col.aabb.width, col.aabb.height });
+                index->objects.push_back(&col);
+            }
+        }
+    }
+    index->stamps.assign(index->boxes.size(), 0);
+
+    if (index->boxes.empty()) {
+        index->cellStart.push_back(0);
+        return;
+    }
+
+    // Grid covers the bounds of the platforms themselves, which may reach outside the tile area
+    float minX = index->boxes[0].x, minY = index->boxes[0].y;
+    float maxX = minX, maxY = minY;
+    for (const Rectangle &box : index->boxes) {
+        minX = fminf(minX, box.x);
+        minY = fminf(minY, box.y);
+        maxX = fmaxf(maxX, box.x + box.width);
+        maxY = fmaxf(maxY, box.y + box.height);
+    }
+    index->originX = minX;
+    index->originY = minY;
+    index->cols = (int)((maxX - minX) / cellSize) + 1;
+    index->rows = (int)((maxY - minY) / cellSize) + 1;
+
+    // Two passes: count boxes per cell, then place them so each cell is one contiguous run
+    index->cellStart.assign(index->cols * index->rows + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<int> cursor;
+        if (pass == 1) {
+            for (size_t c = 1; c < index->cellStart.size(); c++) {
+                index->cellStart[c] += index->cellStart[c - 1];
+            }
+            index->cellItems.resize(index->cellStart.back());
+            cursor.assign(index->cellStart.begin(), index->cellStart.end() - 1);
+        }
+        for (size_t b = 0; b < index->boxes.size(); b++) {
+            const Rectangle &box = index->boxes[b];
+            int cx0 = (int)((box.x - minX) / cellSize);
+            int cy0 = (int)((box.y - minY) / cellSize);
+            int cx1 = (int)((box.x + box.width - minX) / cellSize);
+            int cy1 = (int)((box.y + box.height - minY) / cellSize);
+            for (int cy = cy0; cy <= cy1; cy++) {
+                for (int cx = cx0; cx <= cx1; cx++) {
+                    int cell = cy * index->cols + cx;
+                    if (pass == 0) {
+                        index->cellStart[cell + 1]++;
+                    } else {
+                        index->cellItems[cursor[cell]++] = (int)b;
+                    }
+                }
+            }
+        }
+    }
+
+    TraceLog(LOG_INFO, "Collision index: %d platforms in %dx%d cells", (int)index->boxes.size(), index->cols, index->rows);
+}
+
+// Fill 'out' with the indices of all boxes overlapping 'area', in the same order they appear in the map
+int QueryCollisionIndex(CollisionIndex *index, Rectangle area, std::vector<int> &out)
+{
+    out.clear();
+    if (index->cols == 0) {
+        return 0;
+    }
+
+    int cx0 = (int)floorf((area.x - index->originX) / index->cellSize);
+    int cy0 = (int)floorf((area.y - index->originY) / index->cellSize);
+    int cx1 = (int)floorf((area.x + area.width - index->originX) / index->cellSize);
+    int cy1 = (int)floorf((area.y + area.height - index->originY) / index->cellSize);
+    if (cx1 < 0 || cy1 < 0 || cx0 >= index->cols || cy0 >= index->rows) {
+        return 0;
+    }
+    cx0 = std::max(cx0, 0);
+    cy0 = std::max(cy0, 0);
+    cx1 = std::min(cx1, index->cols - 1);
+    cy1 = std::min(cy1, index->rows - 1);
+
+    if (++index->queryStamp == 0) {
+        // Stamp wrapped around, forget every previous query
+        std::fill(index->stamps.begin(), index->stamps.end(), 0);
+        index->queryStamp = 1;
+    }
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int cell = cy * index->cols + cx;
+            for (int k = index->cellStart[cell]; k < index->cellStart[cell + 1]; k++) {
+                int b = index->cellItems[k];
+                if (index->stamps[b] != index->queryStamp && CheckCollisionRecs(area, index->boxes[b])) {
+                    index->stamps[b] = index->queryStamp;
+                    out.push_back(b);
+                }
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return (int)out.size();
+}
+
+long long gridCellKey(int cx, int cy)
+{
+    return ((long long)cy << 32) | (unsigned int)cx;
+}
+
+void gridLink(SpatialHashGrid *grid, int id)
+{
+    GridItem &item = grid->items[id];
+    item.cx0 = (int)floorf(item.rect.x / grid->cellSize);
+    item.cy0 = (int)floorf(item.rect.y / grid->cellSize);
+    item.cx1 = (int)floorf((item.rect.x + item.rect.width) / grid->cellSize);
+    item.cy1 = (int)floorf((item.rect.y + item.rect.height) / grid->cellSize);
+    for (int cy = item.cy0; cy <= item.cy1; cy++) {
+        for (int cx = item.cx0; cx <= item.cx1; cx++) {
+            grid->cells[gridCellKey(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void gridUnlink(SpatialHashGrid *grid, int id)
+{
+    const GridItem &item = grid->items[id];
+    for (int cy = item.cy0; cy <= item.cy1; cy++) {
+        for (int cx = item.cx0; cx <= item.cx1; cx++) {
+            auto cell = grid->cells.find(gridCellKey(cx, cy));
+            if (cell == grid->cells.end()) {
+                continue;
+            }
+            std::vector<int> &ids = cell->second;
+            for (size_t k = 0; k < ids.size(); k++) {
+                if (ids[k] == id) {
+                    ids[k] = ids.back();
+                    ids.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Register an entity and return the id it is tracked under
+int gridInsert(SpatialHashGrid *grid, Rectangle rect, EntityKind kind, int owner)
+{
+    int id;
+    if (!grid->freeIds.empty()) {
+        id = grid->freeIds.back();
+        grid->freeIds.pop_back();
+    } else {
+        id = (int)grid->items.size();
+        grid->items.push_back({});
+        grid->stamps.push_back(0);
+    }
+    grid->items[id] = { rect, kind, owner, 0, 0, 0, 0, true };
+    gridLink(grid, id);
+    return id;
+}
+
+// Update an entity's bounds, only touching the cells if it crossed into different ones
+void gridMove(SpatialHashGrid *grid, int id, Rectangle rect)
+{
+    GridItem &item = grid->items[id];
+    int cx0 = (int)floorf(rect.x / grid->cellSize);
+    int cy0 = (int)floorf(rect.y / grid->cellSize);
+    int cx1 = (int)floorf((rect.x + rect.width) / grid->cellSize);
+    int cy1 = (int)floorf((rect.y + rect.height) / grid->cellSize);
+    if (cx0 == item.cx0 && cy0 == item.cy0 && cx1 == item.cx1 && cy1 == item.cy1) {
+        item.rect = rect;
+        return;
+    }
+    gridUnlink(grid, id);
+    item.rect = rect;
+    gridLink(grid, id);
+}
+
+void gridRemove(SpatialHashGrid *grid, int id)
+{
+    gridUnlink(grid, id);
+    grid->items[id].alive = false;
+    grid->freeIds.push_back(id);
+}
+
+// Point an item at a new slot in its entity vector, after that vector was compacted
+void gridSetOwner(SpatialHashGrid *grid, int id, int owner)
+{
+    grid->items[id].owner = owner;
+}
+
+void gridClear(SpatialHashGrid *grid)
+{
+    grid->items.clear();
+    grid->freeIds.clear();
+    grid->cells.clear();
+    grid->stamps.clear();
+    grid->queryStamp = 0;
+}
+
+// Fill 'out' with the vector indices of every entity of the given kind overlapping 'area', lowest index first
+int gridQueryRect(SpatialHashGrid *grid, Rectangle area, EntityKind kind, std::vector<int> &out)
+{
+    out.clear();
+    if (++grid->queryStamp == 0) {
+        std::fill(grid->stamps.begin(), grid->stamps.end(), 0);
+        grid->queryStamp = 1;
+    }
+
+    int cx0 = (int)floorf(area.x / grid->cellSize);
+    int cy0 = (int)floorf(area.y / grid->cellSize);
+    int cx1 = (int)floorf((area.x + area.width) / grid->cellSize);
+    int cy1 = (int)floorf((area.y + area.height) / grid->cellSize);
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            auto cell = grid->cells.find(gridCellKey(cx, cy));
+            if (cell == grid->cells.end()) {
+                continue;
+            }
+            for (int id : cell->second) {
+                const GridItem &item = grid->items[id];
+                if (item.kind == kind && grid->stamps[id] != grid->queryStamp && CheckCollisionRecs(area, item.rect)) {
+                    grid->stamps[id] = grid->queryStamp;
+                    out.push_back(item.owner);
+                }
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return (int)out.size();
+}
 
-double timer = GetTime();
-double finishTime = timer + 1.0;
+Animation start_animation(int clip)
+{
+    return { clip, ANIMATION_CLIPS[clip].fst, ANIMATION_CLIPS[clip].spd };
+}
+
+// Switch to another clip from its first frame, or keep playing if it's already the current one
+void play_animation(Animation *self, int clip)
+{
+    if (self->clip != clip) {
+        *self = start_animation(clip);
+    }
+}
 
-void update_animation(Animation *self)
+// Advance a contiguous run of animations by dt
+void update_animations(Animation *anims, size_t count, float dt)
 {
-    float dt = GetFrameTime();
-    self->rem -= dt;
-    if (self->rem < 0)
+    for (size_t i = 0; i < count; i++)
     {
-        self->rem = self->spd;
-        self->cur++;
-        if (self->cur > self->lst)
+        Animation *self = &anims[i];
+        self->rem -= dt;
+        if (self->rem < 0)
         {
-            switch (self->type)
+            const AnimationClip &clip = ANIMATION_CLIPS[self->clip];
+            self->rem = clip.spd;
+            self->cur++;
+            if (self->cur > clip.lst)
             {
-            case REPEATING:
-                self->cur = self->fst;
-                break;
-            case ONESHOT:
-                self->cur = self->lst;
-                break;
+                switch (clip.type)
+                {
+                case REPEATING:
+                    self->cur = clip.fst;
+                    break;
+                case ONESHOT:
+                    self->cur = clip.lst;
+                    break;
+                }
             }
         }
     }
@@ -195,35 +931,91 @@ void update_animation(Animation *self)
 
 Rectangle animation_frame(const Animation *self)
 {
-    int x = (self->cur % (self->lst + 1)) * self->width;
-    int y = self->offset * self->height;
-    return (Rectangle){(float)x, (float)y, (float)self->width, (float)self->height};
+    const AnimationClip &clip = ANIMATION_CLIPS[self->clip];
+    int x = (self->cur % (clip.lst + 1)) * clip.width;
+    int y = clip.offset * clip.height;
+    return (Rectangle){(float)x, (float)y, (float)clip.width, (float)clip.height};
 }
 
-void drawPlayer(const Player *player)
+SpriteBatch spriteBatch;
+
+void batchSprite(SpriteBatch *batch, Texture2D texture, Rectangle source, Rectangle dest, SpriteLayer layer, Color tint = WHITE)
 {
-    if (player->state < 0 || player->state >= player->animations.size())
-    {
-        TraceLog(LOG_ERROR, "Invalid animation state: %d", player->state);
-        return;
+    batch->quads.push_back({ texture, source, dest, tint, layer, (int)batch->quads.size() });
+}
+
+// Draw every queued quad, grouped so that each texture is bound as few times as possible
+void flushSprites(SpriteBatch *batch)
+{
+    std::sort(batch->quads.begin(), batch->quads.end(), [](const SpriteQuad &a, const SpriteQuad &b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.texture.id != b.texture.id) return a.texture.id < b.texture.id;
+        return a.order < b.order;
+    });
+
+    unsigned int boundTexture = 0;
+    for (const SpriteQuad &quad : batch->quads) {
+        if (quad.texture.id != boundTexture) {
+            boundTexture = quad.texture.id;
+            batch->textureSwitches++;
+        }
+        DrawTexturePro(quad.texture, quad.source, quad.dest, {0, 0}, 0.0f, quad.tint);
     }
-    Rectangle source = animation_frame(&(player->animations[player->state]));
+    batch->quadsDrawn += (int)batch->quads.size();
+    batch->quads.clear();
+}
+
+CullStats cullStats;
+bool showRenderStats = false;  // F3
+
+// Grid rects are the last sim step's, and enemies are indexed by hitbox rather than sprite, so the view is grown by
+// enough to cover both the interpolated draw position and the sprite
+const float CULL_MARGIN = 64.0f;
+
+// The world-space rect the camera sees, grown by 'margin' on every side
+Rectangle cameraView(const Camera2D *camera, float margin)
+{
+    float width = W / camera->zoom;
+    float height = H / camera->zoom;
+    return {
+        camera->target.x - camera->offset.x / camera->zoom - margin,
+        camera->target.y - camera->offset.y / camera->zoom - margin,
+        width + 2 * margin,
+        height + 2 * margin
+    };
+}
+
+void countCulled(int drawn, int total)
+{
+    cullStats.drawn += drawn;
+    cullStats.culled += total - drawn;
+}
+
+Rectangle lerpRect(Rectangle from, Rectangle to, float t)
+{
+    return { from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t, to.width, to.height };
+}
+
+void drawPlayer(const Player *player, float alpha)
+{
+    Rectangle source = animation_frame(&(player->anim));
     source.width = source.width * static_cast<float>(player->dir);
+    source = atlasSource(&player->sprite, source);
     
     //DrawRectangleRec(player->rect, GREEN);//Debug for player collision and spritebox
     //DrawRectangleRec(player->hitbox, RED);//Debug for Hitbox
-    DrawTexturePro(player->sprite, source, player->rect, {0, 0}, 0.0f, WHITE);
+    batchSprite(&spriteBatch, player->sprite.texture, source, lerpRect(player->prevRect, player->rect, alpha), SPRITE_LAYER_ACTORS);
 }
 
-void movePlayer(Player *player)
+void movePlayer(Player *player, const SimInput *input, float dt)
 {
     player->vel.x = 0.0f;
     bool changedState = false;
 
     // Handle knockback smoothly
     if (player->knockbackTime > 0) {
-        player->rect.x += player->knockbackVel.x * GetFrameTime();
-        player->knockbackTime -= GetFrameTime();
+        player->rect.x += player->knockbackVel.x * dt;
+        player->knockbackTime -= dt;
 
         if (player->knockbackTime <= 0) {
             player->knockbackVel.x = 0;  // Stop knockback after time runs out
@@ -232,14 +1024,14 @@ void movePlayer(Player *player)
     }
 
     // Regular movement
-    if (IsKeyDown(KEY_A)) {
+    if (input->left) {
         player->vel.x = -200.0f;
         player->dir = LEFT;
         if (player->vel.y == 0.0f) {
             player->state = CurrentState::RUNNING;
             changedState = true;
         }
-    } else if (IsKeyDown(KEY_D)) {
+    } else if (input->right) {
         player->vel.x = 200.0f;
         player->dir = RIGHT;
         if (player->vel.y == 0.0f) {
@@ -249,7 +1041,7 @@ void movePlayer(Player *player)
     }
 
     // Jump Logic
-    if (IsKeyPressed(KEY_SPACE) && !player->isJumping) {
+    if (input->jumpPressed && !player->isJumping) {
         player->jumpTime = 0.0f;
         player->vel.y = JUMP_FORCE;
         player->state = CurrentState::JUMPING;
@@ -259,8 +1051,8 @@ void movePlayer(Player *player)
     }
 
     // Holding SPACE boosts jump height
-    if (IsKeyDown(KEY_SPACE) && player->isJumping) {
-        player->jumpTime += GetFrameTime();
+    if (input->jumpDown && player->isJumping) {
+        player->jumpTime += dt;
         if (player->jumpTime < MAX_JUMP_HOLD) {
             player->vel.y = JUMP_BOOST;
             changedState = true;
@@ -268,7 +1060,7 @@ void movePlayer(Player *player)
     }
 
     // Stop boosting when SPACE is released
-    if (IsKeyReleased(KEY_SPACE) && player->isJumping) {
+    if (input->jumpReleased && player->isJumping) {
         player->jumpTime = MAX_JUMP_HOLD;
         changedState = true;
     }
@@ -297,57 +1089,54 @@ Color getOrbColor(float score) {
     return Color{ (unsigned char)r, (unsigned char)g, (unsigned char)b, 255 };
 }
 
-void spawnOrb(TmxMap* map, const Camera2D &camera, std::vector<Score_Orb> &orbs) {
+void spawnOrb(const Camera2D &camera, std::vector<Score_Orb> &orbs) {
     float viewX = camera.target.x - (W / 2.0f) / camera.zoom;
     float viewY = camera.target.y - (H / 2.0f) / camera.zoom;
     float viewW = W / camera.zoom;
     float viewH = H / camera.zoom;
     Rectangle viewRect = { viewX, viewY, viewW, viewH };
 
-    
-    for (unsigned int i = 0; i < map->layersLength; i++) {
-        if (strcmp(map->layers[i].name, "collisions") == 0 && map->layers[i].type == LAYER_TYPE_OBJECT_GROUP) {
-            TmxObjectGroup &objectGroup = map->layers[i].exact.objectGroup;
-            for (unsigned int j = 0; j < objectGroup.objectsLength; j++) {
-                TmxObject &col = objectGroup.objects[j];
-                Rectangle platform = { col.aabb.x, col.aabb.y, col.aabb.width, col.aabb.height };
-
-                if (CheckCollisionRecs(platform, viewRect)) {
-                    if (spawnedPlatforms.find(&col) == spawnedPlatforms.end()) {
-                        int orbSize = 16;
-                        float orbX = platform.x;
-                        if (platform.width > orbSize) {
-                            orbX += (rand() % (int)(platform.width - orbSize));
-                        }
-                        float orbY = platform.y - orbSize;
-                        float orbScore = (rand() % 500) + 1;
-                        Color orbColor = getOrbColor(orbScore);
-                        Score_Orb newOrb = {
-                            { orbX, orbY, (float)orbSize, (float)orbSize },
-                            orbScore,
-                            orbColor,
-                            false
-                        };
-                        orbs.push_back(newOrb);
-                        spawnedPlatforms.insert(&col);
-                    }
-                }
+    QueryCollisionIndex(&collisionIndex, viewRect, collisionCandidates);
+    for (int b : collisionCandidates) {
+        TmxObject *col = collisionIndex.objects[b];
+        const Rectangle &platform = collisionIndex.boxes[b];
+
+        if (spawnedPlatforms.find(col) == spawnedPlatforms.end()) {
+            int orbSize = 16;
+            float orbX = platform.x;
+            if (platform.width > orbSize) {
+                orbX += (rand() % (int)(platform.width - orbSize));
             }
+            float orbY = platform.y - orbSize;
+            float orbScore = (rand() % 500) + 1;
+            Color orbColor = getOrbColor(orbScore);
+            Score_Orb newOrb = {
+                { orbX, orbY, (float)orbSize, (float)orbSize },
+                orbScore,
+                orbColor,
+                false,
+                gridInsert(&entityGrid, { orbX, orbY, (float)orbSize, (float)orbSize }, ENT_ORB, (int)orbs.size())
+            };
+            orbs.push_back(newOrb);
+            spawnedPlatforms.insert(col);
         }
     }
-    
 }
 
 void checkOrbCollection(Player *player, std::vector<Score_Orb> &orbs) {
-    for (auto it = orbs.begin(); it != orbs.end();) {
-        if (CheckCollisionRecs(player->rect, it->rect)) {
-            player->score += 1;
-            // Play collect sound
-            PlaySound(collectSound);
-            it = orbs.erase(it);
-        } else {
-            ++it;
+    gridQueryRect(&entityGrid, player->rect, ENT_ORB, entityCandidates);
+    // Highest index first so swapping the last orb into a freed slot never disturbs one still to be visited
+    for (auto it = entityCandidates.rbegin(); it != entityCandidates.rend(); ++it) {
+        size_t i = (size_t)*it;
+        player->score += 1;
+        // Play collect sound
+        PlaySound(collectSound);
+        gridRemove(&entityGrid, orbs[i].gridId);
+        if (i != orbs.size() - 1) {
+            orbs[i] = orbs.back();
+            gridSetOwner(&entityGrid, orbs[i].gridId, (int)i);
         }
+        orbs.pop_back();
     }
 }
 
@@ -358,88 +1147,116 @@ void drawOrbs(const std::vector<Score_Orb> &orbs) {
     }
 }
 
-void applyGravity(Vector2 *vel) {
-    vel->y += 1000.0f * GetFrameTime();  // Increase gravity effect
+void applyGravity(Vector2 *vel, float dt) {
+    vel->y += 1000.0f * dt;  // Increase gravity effect
     if (vel->y > MAX_GRAV) {
         vel->y = MAX_GRAV;  // Cap fall speed
     }
 }
 
-void moveRectByVel(Rectangle *rect, const Vector2 *vel)
+void moveRectByVel(Rectangle *rect, const Vector2 *vel, float dt)
+{
+    rect->x += vel->x * dt;
+    rect->y += vel->y * dt;
+}
+
+
+
+void checkTileCollisions(Player *player, float dt) {
+    bool wasJumping = player->isJumping;
+
+    // Resolving one platform can push the player up to a body length, so widen the query by that much
+    Rectangle area = {
+        player->rect.x - player->rect.width, player->rect.y - player->rect.height,
+        player->rect.width * 3, player->rect.height * 3
+    };
+    QueryCollisionIndex(&collisionIndex, area, collisionCandidates);
+
+    for (int b : collisionCandidates) {
+        const Rectangle &platform = collisionIndex.boxes[b];
+        if (CheckCollisionRecs(player->rect, platform)) {
+            TraceLog(LOG_DEBUG, "Collision detected!");
+
+            // Compute previous position
+            float previousX = player->rect.x - player->vel.x * dt;
+            float previousY = player->rect.y - player->vel.y * dt;
+
+            // Determine collision direction
+            bool comingFromTop = previousY + player->rect.height <= platform.y;
+            bool comingFromBottom = previousY >= platform.y + platform.height;
+            bool comingFromLeft = previousX + player->rect.width <= platform.x;
+            bool comingFromRight = previousX >= platform.x + platform.width;
+
+            if (comingFromTop) {
+                // Standing on platform
+                player->vel.y = 0.0f;
+                player->rect.y = platform.y - player->rect.height;
+                player->isJumping = false; // Allow jumping again
+                
+                // Play landing sound if player was jumping before
+                if (wasJumping) {
+                    PlaySound(landSound);
+                }
+            } else if (comingFromBottom) {
+                // Hitting the bottom of the platform
+                player->vel.y = 0.0f;
+                player->rect.y = platform.y + platform.height;
+            } else if (comingFromLeft) {
+                // Hitting the left side
+                player->vel.x = 0.0f;
+                player->rect.x = platform.x - player->rect.width;
+            } else if (comingFromRight) {
+                // Hitting the right side
+                player->vel.x = 0.0f;
+                player->rect.x = platform.x + platform.width;
+            }
+        }
+    }
+}
+
+void clearEnemies()
 {
-    rect->x += vel->x * GetFrameTime();
-    rect->y += vel->y * GetFrameTime();
+    enemies.x.clear(); enemies.y.clear();
+    enemies.prevX.clear(); enemies.prevY.clear();
+    enemies.velX.clear(); enemies.velY.clear();
+    enemies.hitX.clear(); enemies.hitY.clear();
+    enemies.dir.clear();
+    enemies.e_state.clear();
+    enemies.anim.clear();
+    enemies.gridId.clear();
 }
 
-
-
-void checkTileCollisions(TmxMap *map, Player *player) {
-    bool wasJumping = player->isJumping;
-    
-    for (unsigned int i = 0; i < map->layersLength; i++) {
-        if (strcmp(map->layers[i].name, "collisions") == 0 && map->layers[i].type == LAYER_TYPE_OBJECT_GROUP) {
-            TmxObjectGroup &objectGroup = map->layers[i].exact.objectGroup;
-            for (unsigned int j = 0; j < objectGroup.objectsLength; j++) {
-                TmxObject &col = objectGroup.objects[j];
-                Rectangle platform = { col.aabb.x, col.aabb.y, col.aabb.width, col.aabb.height };
-                platforms.push_back(platform);
-                if (CheckCollisionRecs(player->rect, platform)) {
-                    TraceLog(LOG_DEBUG, "Collision detected!");
-
-                    // Compute previous position
-                    float previousX = player->rect.x - player->vel.x * GetFrameTime();
-                    float previousY = player->rect.y - player->vel.y * GetFrameTime();
-
-                    // Determine collision direction
-                    bool comingFromTop = previousY + player->rect.height <= platform.y;
-                    bool comingFromBottom = previousY >= platform.y + platform.height;
-                    bool comingFromLeft = previousX + player->rect.width <= platform.x;
-                    bool comingFromRight = previousX >= platform.x + platform.width;
-
-                    if (comingFromTop) {
-                        // Standing on platform
-                        player->vel.y = 0.0f;
-                        player->rect.y = platform.y - player->rect.height;
-                        player->isJumping = false; // Allow jumping again
-                        
-                        // Play landing sound if player was jumping before
-                        if (wasJumping) {
-                            PlaySound(landSound);
-                        }
-                    } else if (comingFromBottom) {
-                        // Hitting the bottom of the platform
-                        player->vel.y = 0.0f;
-                        player->rect.y = platform.y + platform.height;
-                    } else if (comingFromLeft) {
-                        // Hitting the left side
-                        player->vel.x = 0.0f;
-                        player->rect.x = platform.x - player->rect.width;
-                    } else if (comingFromRight) {
-                        // Hitting the right side
-                        player->vel.x = 0.0f;
-                        player->rect.x = platform.x + platform.width;
-                    }
-                }
-            }
-        }
+// Remove enemy i in O(1) by moving the last enemy into its slot
+void removeEnemy(size_t i)
+{
+    gridRemove(&entityGrid, enemies.gridId[i]);
+    size_t last = enemies.size() - 1;
+    if (i != last) {
+        enemies.x[i] = enemies.x[last]; enemies.y[i] = enemies.y[last];
+        enemies.prevX[i] = enemies.prevX[last]; enemies.prevY[i] = enemies.prevY[last];
+        enemies.velX[i] = enemies.velX[last]; enemies.velY[i] = enemies.velY[last];
+        enemies.hitX[i] = enemies.hitX[last]; enemies.hitY[i] = enemies.hitY[last];
+        enemies.dir[i] = enemies.dir[last];
+        enemies.e_state[i] = enemies.e_state[last];
+        enemies.anim[i] = enemies.anim[last];
+        enemies.gridId[i] = enemies.gridId[last];
+        gridSetOwner(&entityGrid, enemies.gridId[i], (int)i);
     }
+    enemies.x.pop_back(); enemies.y.pop_back();
+    enemies.prevX.pop_back(); enemies.prevY.pop_back();
+    enemies.velX.pop_back(); enemies.velY.pop_back();
+    enemies.hitX.pop_back(); enemies.hitY.pop_back();
+    enemies.dir.pop_back();
+    enemies.e_state.pop_back();
+    enemies.anim.pop_back();
+    enemies.gridId.pop_back();
 }
 
 // Spawn Enemy either on the left or right side of the screen to which they will move to the opposite side
-void spawnEnemy(Camera2D camera, Texture2D enemyTexture)
+void spawnEnemy(Camera2D camera)
 {   
-    Enemy enemy = {
-        .rect = {0, 0, 64.0f, 64.0f},
-        .hitbox = {0, 0, 48.0f, 48.0f},
-        .vel = {0.0f, 0.0f},
-        .sprite = enemyTexture,
-        .dir = (GetRandomValue(0, 1) == 0) ? LEFT : RIGHT,
-        .e_state = EnemyState::E_MOVING,
-        .animations = {
-            {0, 4, 0, 0, 48, 48, 0.1f, 0.1f, ONESHOT},
-            {0, 4, 0, 0, 48, 48, 0.1f, 0.1f, REPEATING},
-        }
-    };
+    Direction dir = (GetRandomValue(0, 1) == 0) ? LEFT : RIGHT;
+    EnemyState state = EnemyState::E_MOVING;
 
     // Get camera boundaries (view area)
     float camX = camera.target.x - (W / 2.0f) / camera.zoom;
@@ -448,23 +1265,49 @@ void spawnEnemy(Camera2D camera, Texture2D enemyTexture)
     float camH = H / camera.zoom;
 
     // Randomly spawn left or right of the camera view
-    if (enemy.dir == RIGHT) {
-        enemy.rect.x = camX - 100;  // Spawn slightly off-screen left
+    float x;
+    if (dir == RIGHT) {
+        x = camX - 100;  // Spawn slightly off-screen left
     } else {
-        enemy.rect.x = camX + camW + 100;  // Spawn slightly off-screen right
+        x = camX + camW + 100;  // Spawn slightly off-screen right
     }
 
     // Spawn at a random height within the camera view
-    enemy.rect.y = GetRandomValue(camY, camY + camH - enemy.rect.height);
+    float y = GetRandomValue(camY, camY + camH - ENEMY_SIZE);
 
     // Assign a random speed
-    enemy.vel.x = GetRandomValue(100, 300) * ((enemy.dir == RIGHT) ? 1 : -1);
+    float velX = GetRandomValue(100, 300) * ((dir == RIGHT) ? 1 : -1);
+
+    Rectangle hitbox = { x + ENEMY_HITBOX_OFFSET, y + ENEMY_HITBOX_OFFSET, ENEMY_HITBOX_SIZE, ENEMY_HITBOX_SIZE };
+    enemies.gridId.push_back(gridInsert(&entityGrid, hitbox, ENT_ENEMY, (int)enemies.size()));
+    enemies.x.push_back(x); enemies.y.push_back(y);
+    enemies.prevX.push_back(x); enemies.prevY.push_back(y);
+    enemies.velX.push_back(velX); enemies.velY.push_back(0.0f);
+    enemies.hitX.push_back(hitbox.x); enemies.hitY.push_back(hitbox.y);
+    enemies.dir.push_back(dir);
+    enemies.e_state.push_back(state);
+    enemies.anim.push_back(start_animation(CLIP_FLY_EYE));
+}
 
-    enemies.push_back(enemy);
+// Integrate every enemy in one branch-free pass over plain float arrays. The __restrict parameters tell the
+// compiler the arrays never overlap, which is what lets it vectorize the loop (the Makefile enables the loop
+// vectorizer for release builds).
+void integrateEnemies(size_t n, float dt, float *__restrict x, float *__restrict y,
+    float *__restrict prevX, float *__restrict prevY, const float *__restrict velX, const float *__restrict velY,
+    float *__restrict hitX, float *__restrict hitY)
+{
+    for (size_t i = 0; i < n; i++) {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+        x[i] += velX[i] * dt;
+        y[i] += velY[i] * dt;
+        hitX[i] = x[i] + ENEMY_HITBOX_OFFSET;
+        hitY[i] = y[i] + ENEMY_HITBOX_OFFSET;
+    }
 }
 
 // Move enemy
-void moveEnemy(TmxMap *map) {
+void moveEnemy(TmxMap *map, float dt) {
     float mapWidth = 0;
     float mapHeight = 0;
 
@@ -477,39 +1320,31 @@ void moveEnemy(TmxMap *map) {
         }
     }
 
-    // Iterate through enemies and remove those that leave the map
-    for (size_t i = 0; i < enemies.size();) {
-        if (enemies[i].e_state == EnemyState::E_MOVING) {
-            // Move enemy
-            moveRectByVel(&(enemies[i].rect), &(enemies[i].vel));
-
-            // Bounce off walls
-            
+    integrateEnemies(enemies.size(), dt, enemies.x.data(), enemies.y.data(), enemies.prevX.data(), enemies.prevY.data(),
+        enemies.velX.data(), enemies.velY.data(), enemies.hitX.data(), enemies.hitY.data());
 
-            // **Check if the enemy is completely outside the map area**
-            float despawnMargin = 200.0f;  // Extra margin before despawning
-            if (enemies[i].rect.x < -despawnMargin || enemies[i].rect.x > mapWidth + despawnMargin ||
-                enemies[i].rect.y < -despawnMargin || enemies[i].rect.y > mapHeight + despawnMargin) {
-                
-                TraceLog(LOG_INFO, "Despawning enemy at (%.2f, %.2f)", enemies[i].rect.x, enemies[i].rect.y);
-                enemies.erase(enemies.begin() + i);  // Remove enemy
-                continue;  // Skip incrementing 'i' since an enemy was removed
-            }
+    // Remove enemies that leave the map and tell the grid where the rest went
+    float despawnMargin = 200.0f;  // Extra margin before despawning
+    for (size_t i = 0; i < enemies.size();) {
+        // **Check if the enemy is completely outside the map area**
+        if (enemies.e_state[i] == EnemyState::E_MOVING &&
+            (enemies.x[i] < -despawnMargin || enemies.x[i] > mapWidth + despawnMargin ||
+             enemies.y[i] < -despawnMargin || enemies.y[i] > mapHeight + despawnMargin)) {
+            TraceLog(LOG_INFO, "Despawning enemy at (%.2f, %.2f)", enemies.x[i], enemies.y[i]);
+            removeEnemy(i);
+            continue;  // Skip incrementing 'i', slot i now holds the former last enemy
         }
 
-        // Update hitbox
-        enemies[i].hitbox.x = enemies[i].rect.x + 12;
-        enemies[i].hitbox.y = enemies[i].rect.y + 12;
-
+        gridMove(&entityGrid, enemies.gridId[i], { enemies.hitX[i], enemies.hitY[i], ENEMY_HITBOX_SIZE, ENEMY_HITBOX_SIZE });
         i++;  // Increment only if no enemy was removed
     }
 }
 
-void enableInvulnerability(Player *player)
+void enableInvulnerability(Player *player, double now)
 {
     player->invulnerable = true;
 
-    timer = GetTime();
+    timer = now;
     if (timer >= finishTime)
     {
         player->invulnerable = false;
@@ -517,31 +1352,30 @@ void enableInvulnerability(Player *player)
 }
 
 // Checks Collisions between player and enemy and bullets
-void hitCheck(Player *player, DeathTransition *transition)
+void hitCheck(Player *player, DeathTransition *transition, double now)
 {
-    for(size_t i = 0; i < enemies.size(); i++) {
-        if (CheckCollisionRecs(player->hitbox, enemies[i].hitbox)) {
-            if (!player->invulnerable) {
-                player->health -= 5;
-                player->state = CurrentState::HIT;
-                
-                // Apply smooth knockback instead of teleporting
-                float knockbackForce = 300.0f;  // Adjust force as needed
-                if (player->dir == RIGHT) {
-                    player->knockbackVel.x = -knockbackForce;  // Push left
-                } else {
-                    player->knockbackVel.x = knockbackForce;   // Push right
-                }
-
-                player->knockbackTime = 0.3f;  // Knockback lasts 0.3 seconds
-                timer = GetTime();
-                finishTime = timer + 1.0;
-                // Play hit sound
-                PlaySound(hitSound);
-            }
+    gridQueryRect(&entityGrid, player->hitbox, ENT_ENEMY, entityCandidates);
+    for (size_t k = 0; k < entityCandidates.size(); k++) {
+        if (!player->invulnerable) {
+            player->health -= 5;
+            player->state = CurrentState::HIT;
             
-            enableInvulnerability(player);
+            // Apply smooth knockback instead of teleporting
+            float knockbackForce = 300.0f;  // Adjust force as needed
+            if (player->dir == RIGHT) {
+                player->knockbackVel.x = -knockbackForce;  // Push left
+            } else {
+                player->knockbackVel.x = knockbackForce;   // Push right
+            }
+
+            player->knockbackTime = 0.3f;  // Knockback lasts 0.3 seconds
+            timer = now;
+            finishTime = timer + 1.0;
+            // Play hit sound
+            PlaySound(hitSound);
         }
+        
+        enableInvulnerability(player, now);
     }
 
     // If player's health reaches 0, start death transition
@@ -613,9 +1447,9 @@ void checkHorizontalBoundaries(Player* player, TmxMap* map, DeathTransition* tra
 }
 
 // Update death transition effect
-bool updateDeathTransition(DeathTransition* transition) {
+bool updateDeathTransition(DeathTransition* transition, float dt) {
     if (transition->active) {
-        transition->timer += GetFrameTime();
+        transition->timer += dt;
         transition->alpha = transition->timer / transition->duration;
         
         // Clamp alpha between 0 and 1
@@ -628,7 +1462,7 @@ bool updateDeathTransition(DeathTransition* transition) {
     return false;
 }
 
-void LoadSpikesFromTMX(TmxMap* map, Player *player){
+void LoadSpikesFromTMX(TmxMap* map, std::vector<Spike> *out){
     for (unsigned int i = 0; i < map->layersLength; i++) {
         if (strcmp(map->layers[i].name, "spikes") == 0 && map->layers[i].type == LAYER_TYPE_OBJECT_GROUP) {
             TmxObjectGroup& objectGroup = map->layers[i].exact.objectGroup;
@@ -645,34 +1479,34 @@ void LoadSpikesFromTMX(TmxMap* map, Player *player){
                     spike.timer = 0.5f;  // Random time for spike to rise/fall
                     spike.rising = true;  // Start by moving up
                     spike.startY = spike.rect.y; 
-                    spike.texture = LoadTexture("assets/tiles-and-background-foreground/spike.png");
+                    spike.sprite = AcquireSprite("assets/tiles-and-background-foreground/spike.png", SCOPE_LEVEL);
                     spike.moving = true;   
-                    spikes.push_back(spike);
+                    spike.gridId = -1;  // Inserted into the grid when a run spawns it
+                    out->push_back(spike);
             }
         }
     }
 }
 
 void checkSpikeCol(Player* player, DeathTransition* transition){
-    for (size_t i = 0; i < spikes.size(); i++){
-        if(CheckCollisionRecs(player->hitbox, spikes[i].rect)){
-            player->health = 0;
-            player->state = DEAD;
-            transition->active = true;
-            transition->alpha = 0.0f;
-            transition->timer = 0.0f;
-            // Play death sound
-            PlaySound(spiked);
-            //PlaySound(deathSound);
-            TraceLog(LOG_INFO, "Player died to spikes!");
-        }
+    gridQueryRect(&entityGrid, player->hitbox, ENT_SPIKE, entityCandidates);
+    for (size_t k = 0; k < entityCandidates.size(); k++){
+        player->health = 0;
+        player->state = DEAD;
+        transition->active = true;
+        transition->alpha = 0.0f;
+        transition->timer = 0.0f;
+        // Play death sound
+        PlaySound(spiked);
+        //PlaySound(deathSound);
+        TraceLog(LOG_INFO, "Player died to spikes!");
     }
 }
 
-void UpdateSpikes(Player *player) {
+void UpdateSpikes(Player *player, float dt) {
     for (size_t i = 0; i < spikes.size(); i++) {
         // Decrease the timer
-        spikes[i].timer -= GetFrameTime();
+        spikes[i].timer -= dt;
 
         // Constants for timing
         const float MOVE_DURATION = 1.0f;  // 1 second to move fully
@@ -690,6 +1524,7 @@ void UpdateSpikes(Player *player) {
             } else {
                 spikes[i].rect.y = spikes[i].endY + (progress * MOVE_DISTANCE);
             }
+            gridMove(&entityGrid, spikes[i].gridId, spikes[i].rect);
 
             // Check if movement is complete
             if (spikes[i].timer <= 0) {
@@ -707,7 +1542,7 @@ void UpdateSpikes(Player *player) {
     }
 }
 
-void LoadFallingPlat(TmxMap* map){
+void LoadFallingPlat(TmxMap* map, std::vector<fallingPlat> *out){
         for (unsigned int i = 0; i < map->layersLength; i++) {
             if (strcmp(map->layers[i].name, "fallingPlat") == 0 && map->layers[i].type == LAYER_TYPE_OBJECT_GROUP) {
                 TmxObjectGroup& objectGroup = map->layers[i].exact.objectGroup;
@@ -720,11 +1555,14 @@ void LoadFallingPlat(TmxMap* map){
                     fallingPlat platform;
                     platform.rect = { obj.aabb.x, obj.aabb.y, obj.aabb.width, obj.aabb.height };
                     platform.Pos = platform.rect;
+                    platform.prevRect = platform.rect;
+                    platform.vel = {0.0f, 0.0f};
                     platform.isFalling = false;
                     const float PAUSE_DURATION = 0.5f;
                     platform.timer = PAUSE_DURATION;
+                    platform.gridId = -1;  // Inserted into the grid when a run spawns it
                     
-                    falling_Plat.push_back(platform);
+                    out->push_back(platform);
                 }
         }
     }
@@ -734,25 +1572,28 @@ void resetFallingPlat() {
     for (size_t i = 0; i < falling_Plat.size(); i++){
         falling_Plat[i].isFalling = false;
         falling_Plat[i].rect = falling_Plat[i].Pos;
+        falling_Plat[i].prevRect = falling_Plat[i].rect;
         falling_Plat[i].timer = 0.5f;
+        gridMove(&entityGrid, falling_Plat[i].gridId, falling_Plat[i].rect);
     }
 }
 
-void movePlatByVel(Rectangle *rect, const Vector2 *vel, bool falling) {
+void movePlatByVel(Rectangle *rect, const Vector2 *vel, bool falling, float dt) {
     if (falling == true){
-        rect->y += vel->y * GetFrameTime();
+        rect->y += vel->y * dt;
     }
 }
 
-void updateFallingPlat(Player *player){
-    for (size_t i = 0; i < falling_Plat.size(); i++){
+void updateFallingPlat(Player *player, float dt){
+    gridQueryRect(&entityGrid, player->rect, ENT_FALLING_PLAT, entityCandidates);
+    for (int i : entityCandidates){
         
         if (CheckCollisionRecs(player->rect, falling_Plat[i].rect)) {
             TraceLog(LOG_DEBUG, "Collision detected!");
 
             // Compute previous position
-            float previousX = player->rect.x - player->vel.x * GetFrameTime();
-            float previousY = player->rect.y - player->vel.y * GetFrameTime();
+            float previousX = player->rect.x - player->vel.x * dt;
+            float previousY = player->rect.y - player->vel.y * dt;
 
             // Determine collision direction
             bool comingFromTop = previousY + player->rect.height <= falling_Plat[i].rect.y;
@@ -768,7 +1609,7 @@ void updateFallingPlat(Player *player){
             
                 player->isJumping = false; // Allow jumping again
 
-                falling_Plat[i].timer -= GetFrameTime();
+                falling_Plat[i].timer -= dt;
                 if (falling_Plat[i].timer <= 0){
                     falling_Plat[i].isFalling = true;
                 }
@@ -809,23 +1650,29 @@ void drawScore(int score) {
 }
 
 // Draw enemy
-void drawEnemy()
+void drawEnemy(AtlasSprite sprite, float alpha, Rectangle view)
 {
-    for(size_t i = 0; i < enemies.size(); i++){
-        if (enemies[i].e_state < 0 || enemies[i].e_state >= static_cast<int>(enemies[i].animations.size()))
-        {
-            TraceLog(LOG_ERROR, "Invalid animation state: %d", enemies[i].e_state);
-            return;
-        }
-
-        Rectangle source = animation_frame(&(enemies[i].animations[enemies[i].e_state]));
-        source.width = source.width * static_cast<float>(enemies[i].dir);
+    countCulled(gridQueryRect(&entityGrid, view, ENT_ENEMY, entityCandidates), (int)enemies.size());
+    for(int i : entityCandidates){
+        Rectangle source = animation_frame(&(enemies.anim[i]));
+        source.width = source.width * static_cast<float>(enemies.dir[i]);
+        source = atlasSource(&sprite, source);
         
-        DrawTexturePro(enemies[i].sprite, source, enemies[i].rect, {0, 0}, 0.0f, WHITE);
-        //DrawRectangleRec(enemies[i].hitbox, RED);
+        Rectangle prev = { enemies.prevX[i], enemies.prevY[i], ENEMY_SIZE, ENEMY_SIZE };
+        Rectangle rect = { enemies.x[i], enemies.y[i], ENEMY_SIZE, ENEMY_SIZE };
+        batchSprite(&spriteBatch, sprite.texture, source, lerpRect(prev, rect, alpha), SPRITE_LAYER_ACTORS);
+        //DrawRectangleRec({ enemies.hitX[i], enemies.hitY[i], ENEMY_HITBOX_SIZE, ENEMY_HITBOX_SIZE }, RED);
     }
 }
 
+// Debug overlay under the FPS counter
+void drawRenderStats()
+{
+    DrawText(TextFormat("Entities: %d drawn, %d culled", cullStats.drawn, cullStats.culled), 5, 30, 10, WHITE);
+    DrawText(TextFormat("Sprites: %d quads, %d texture switches", spriteBatch.quadsDrawn, spriteBatch.textureSwitches),
+        5, 42, 10, WHITE);
+}
+
 void drawHealth(int health)
 {
     // Draw health in the bottom-left corner
@@ -838,48 +1685,58 @@ void drawScoreGoal(int scoreGoal){
     DrawText(healthText.c_str(), 10, H - 90, 20, WHITE);
 }
 
-void DrawSpikes() {
-    for (size_t i = 0; i < spikes.size(); i++) {
+void DrawSpikes(Rectangle view) {
+    countCulled(gridQueryRect(&entityGrid, view, ENT_SPIKE, entityCandidates), (int)spikes.size());
+    for (int i : entityCandidates) {
         // Draw the spike texture at the correct position
         //DrawRectangleRec(spikes[i].rect, RED);
-        DrawTexturePro(
-            spikes[i].texture,                 // Texture
-            { 0, 0, (float)spikes[i].texture.width, (float)spikes[i].texture.height }, // Source Rectangle (Full texture)
+        batchSprite(
+            &spriteBatch,
+            spikes[i].sprite.texture,          // Texture
+            spikes[i].sprite.region,           // Source Rectangle (Full image)
             spikes[i].rect,                     // Destination Rectangle
-            { 0, 0 },                           // Origin (top-left corner)
-            0,                                  // Rotation
-            WHITE                               // Color tint
+            SPRITE_LAYER_WORLD
         );
     }
 }
 
-void drawFallingPlat(Texture2D text){
-    for (size_t i = 0; i < falling_Plat.size(); i++) {
+void drawFallingPlat(AtlasSprite text, float alpha, Rectangle view){
+    countCulled(gridQueryRect(&entityGrid, view, ENT_FALLING_PLAT, entityCandidates), (int)falling_Plat.size());
+    for (int i : entityCandidates) {
         // Draw the fallingplat texture at the correct position
         //DrawRectangleRec(falling_Plat[i].rect, RED);
-        DrawTexturePro(
-            text,
-            {0,0, (float)text.width, (float)text.height},
-            falling_Plat[i].rect,
-            {0,0},
-            0,
-            WHITE
+        batchSprite(
+            &spriteBatch,
+            text.texture,
+            text.region,
+            lerpRect(falling_Plat[i].prevRect, falling_Plat[i].rect, alpha),
+            SPRITE_LAYER_WORLD
         );
     }
 }
 
-void drawSolidPlat(Texture2D floor){
-    for (size_t i = 0; i < platforms.size(); i++) {
+void drawSolidPlat(AtlasSprite floor, Rectangle view){
+    const std::vector<Rectangle> &platforms = collisionIndex.boxes;
+    countCulled(QueryCollisionIndex(&collisionIndex, view, collisionCandidates), (int)platforms.size());
+    for (int i : collisionCandidates) {
         // Draw the fallingplat texture at the correct position
         //DrawRectangleRec(platforms[i], RED);
-        DrawTexturePro(
-            floor,
-            {0,0, (float)floor.width*(platforms[i].width/64), (float)floor.height},
-            platforms[i],
-            {0,0},
-            0,
-            WHITE
-        );
+        // One quad per 64px tile, an atlas region can't be wrapped across the whole platform
+        for (float x = 0; x < platforms[i].width; x += 64) {
+            if (platforms[i].x + x + 64 < view.x || platforms[i].x + x > view.x + view.width) {
+                continue;  // Off-screen tile of a long platform
+            }
+            float part = fminf(platforms[i].width - x, 64.0f) / 64.0f;
+            Rectangle source = floor.region;
+            source.width *= part;
+            batchSprite(
+                &spriteBatch,
+                floor.texture,
+                source,
+                {platforms[i].x + x, platforms[i].y, 64 * part, platforms[i].height},
+                SPRITE_LAYER_WORLD
+            );
+        }
     }
     
 }
@@ -920,6 +1777,20 @@ void DrawMainMenu(int selectedOption, Difficulty difficulty) {
     DrawText(instructions, W/2 - instrWidth/2, H - 100, 20, LIGHTGRAY);
 }
 
+// Draw the loading screen with a bar showing how far along the map's load is
+void DrawLoadingScreen(float progress) {
+    const int textFontSize = 30;
+    const int barWidth = 400;
+    const int barHeight = 20;
+
+    const char* loadingText = "LOADING";
+    int loadingWidth = MeasureText(loadingText, textFontSize);
+    DrawText(loadingText, W/2 - loadingWidth/2, H/2 - 60, textFontSize, WHITE);
+
+    DrawRectangleLines(W/2 - barWidth/2, H/2, barWidth, barHeight, WHITE);
+    DrawRectangle(W/2 - barWidth/2 + 2, H/2 + 2, (int)((barWidth - 4) * progress), barHeight - 4, GOLD);
+}
+
 // Draw the game over screen
 void DrawGameOver(int score) {
     const int titleFontSize = 60;
@@ -975,11 +1846,13 @@ void DrawWinScreen(int score) {
 void ResetPlayer(Player* player, const char* mapFile) {
     // Set player to a safe starting position
     player->rect = {0, 1700, 64.0f, 64.0f};
+    player->prevRect = player->rect;
     player->hitbox = {0, 1700, 32.0f, 64.0f};
     player->vel = {0.0f, 0.0f};
     player->knockbackVel = {0.0f, 0.0f};
     player->dir = RIGHT;
     player->state = IDLE;
+    player->anim = start_animation(CLIP_HERO_IDLE);
     player->isJumping = false;
     player->jumpTime = 0.0f;
     player->health = 10;
@@ -997,40 +1870,40 @@ void ResetCamera(Camera2D* camera, const Player* player) {
 // Load all game sounds
 void LoadGameSounds() {
     // Load sound effects
-    jumpSound = LoadSound("assets/sfx/player-jump.wav");
+    jumpSound = AcquireSound("assets/sfx/player-jump.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded jump sound");
     SetSoundVolume(jumpSound, 1.0f); // Full volume
     
-    collectSound = LoadSound("assets/sfx/got-coin.wav");
+    collectSound = AcquireSound("assets/sfx/got-coin.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded collect sound");
     SetSoundVolume(collectSound, 1.0f); // Full volume
     
-    deathSound = LoadSound("assets/sfx/player-lost.wav");
+    deathSound = AcquireSound("assets/sfx/player-lost.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded death sound");
     SetSoundVolume(deathSound, 1.0f); // Full volume
     
-    menuSelectSound = LoadSound("assets/sfx/menu-select.wav");
+    menuSelectSound = AcquireSound("assets/sfx/menu-select.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded menu select sound");
     SetSoundVolume(menuSelectSound, 1.0f); // Full volume
     
     // Use a different sound for game start
-    gameStartSound = LoadSound("assets/sfx/menu-select.wav");
+    gameStartSound = AcquireSound("assets/sfx/menu-select.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded game start sound");
     SetSoundVolume(gameStartSound, 1.0f); // Full volume
     
-    landSound = LoadSound("assets/sfx/land.wav");
+    landSound = AcquireSound("assets/sfx/land.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded land sound");
     SetSoundVolume(landSound, 1.0f); // Full volume
 
-    hitSound = LoadSound("assets/sfx/hurt.wav");
+    hitSound = AcquireSound("assets/sfx/hurt.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded Hit sound");
     SetSoundVolume(hitSound, 1.0f); // Full volume
 
-    spiked = LoadSound("assets/sfx/spiked.wav");
+    spiked = AcquireSound("assets/sfx/spiked.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded spiked sound");
     SetSoundVolume(spiked, 2.0f); // Full volume
 
-    winner = LoadSound("assets/sfx/winner.wav");
+    winner = AcquireSound("assets/sfx/winner.wav", SCOPE_SESSION);
     TraceLog(LOG_INFO, "Loaded win sound");
     SetSoundVolume(spiked, 2.0f); // Full volume
 
@@ -1042,25 +1915,439 @@ void LoadGameSounds() {
 
 // Unload all game sounds
 void UnloadGameSounds() {
-    // Unload sound effects
-    UnloadSound(jumpSound);
-    UnloadSound(collectSound);
-    UnloadSound(deathSound);
-    UnloadSound(menuSelectSound);
-    UnloadSound(gameStartSound);
-    UnloadSound(landSound);
-    UnloadSound(hitSound);
-    UnloadSound(spiked);
+    // Sound effects are released with the rest of the session's assets
     // Unload music
     UnloadMusicStream(menuMusic);
 }
 
-float enemySpawnTimer = 0.0f;
-float enemySpawnInterval = 2.0f; // Start with a 2-second interval
+// Latch this frame's keyboard state into the sim input
+void sampleInput(SimInput *input)
+{
+    input->left = IsKeyDown(KEY_A);
+    input->right = IsKeyDown(KEY_D);
+    input->jumpDown = IsKeyDown(KEY_SPACE);
+    input->jumpPressed |= IsKeyPressed(KEY_SPACE);
+    input->jumpReleased |= IsKeyReleased(KEY_SPACE);
+}
+
+// Switch the player's clip to match its current state
+void syncPlayerClip(Player *player)
+{
+    if (player->state < 0 || player->state >= (int)(sizeof(PLAYER_STATE_CLIPS) / sizeof(PLAYER_STATE_CLIPS[0])))
+    {
+        TraceLog(LOG_ERROR, "Invalid animation state: %d", player->state);
+    } else {
+        play_animation(&(player->anim), PLAYER_STATE_CLIPS[player->state]);
+    }
+}
+
+// Advance gameplay by exactly one fixed step
+void stepGameplay(SimState *sim)
+{
+    Player *player = sim->player;
+    float dt = sim->dt;
+    const float maxFallDistance = 500.0f; // Maximum distance player can fall below camera
+
+    player->prevRect = player->rect;
+    sim->prevCameraTarget = sim->camera->target;
+
+    movePlayer(player, &sim->input, dt);
+    applyGravity(&(player->vel), dt);
+    sim->enemySpawnTimer -= dt;
+    if (sim->enemySpawnTimer <= 0 && enemies.size() < (size_t)maxEnemies) {
+        int numEnemies = GetRandomValue(1, 5);  // Spawn 1-3 enemies
+        for (int i = 0; i < numEnemies; i++) {
+            spawnEnemy(*sim->camera);  // Use camera for positioning
+        }
+
+        sim->enemySpawnInterval = GetRandomValue(1, 2);
+        sim->enemySpawnTimer = sim->enemySpawnInterval;
+    }
+    for (size_t i = 0; i < falling_Plat.size(); i++){
+        falling_Plat[i].prevRect = falling_Plat[i].rect;
+        applyGravity(&falling_Plat[i].vel, dt);
+        movePlatByVel(&falling_Plat[i].rect, &falling_Plat[i].vel, falling_Plat[i].isFalling, dt);
+        gridMove(&entityGrid, falling_Plat[i].gridId, falling_Plat[i].rect);
+    }
+
+    moveRectByVel(&(player->rect), &(player->vel), dt);
+    checkTileCollisions(player, dt);
+    checkSpikeCol(player, sim->transition);
+    syncPlayerClip(player);
+    update_animations(&(player->anim), 1, dt);
+    update_animations(enemies.anim.data(), enemies.anim.size(), dt);
+
+    hitCheck(player, sim->transition, sim->time);
+    cameraFollow(sim->camera, player);
+
+    UpdateSpikes(player, dt);
+    updateFallingPlat(player, dt);
+    checkOrbCollection(player, *sim->orbs);
+
+    // Check horizontal boundaries
+    checkHorizontalBoundaries(player, sim->map, sim->transition);
+
+    // Add a secondary check for falling too far below the camera view
+    float bottomOfScreen = sim->camera->target.y + (H / 2.0f) / sim->camera->zoom;
+    if (player->rect.y > bottomOfScreen + maxFallDistance && !sim->transition->active) {
+        player->health = 0;
+        player->state = DEAD;
+        sim->transition->active = true;
+        sim->transition->alpha = 0.0f;
+        sim->transition->timer = 0.0f;
+        // Play death sound
+        PlaySound(deathSound);
+        TraceLog(LOG_INFO, "Player fell too far below the screen!");
+    }
+
+    // Hits and deaths above change state after the clip was picked, and a death stops stepping
+    syncPlayerClip(player);
+
+    moveEnemy(sim->map, dt);
+    spawnOrb(*sim->camera, *sim->orbs);
+
+    // Edges only count once
+    sim->input.jumpPressed = false;
+    sim->input.jumpReleased = false;
+    sim->time += dt;
+}
+
+Player CreatePlayer(AtlasSprite sprite)
+{
+    Player player = {
+        .rect = {0, 1700, 64.0f, 64.0f},
+        .vel = {0.0f, 0.0f},
+        .sprite = sprite,
+        .dir = RIGHT,
+        .state = IDLE,
+        .anim = start_animation(CLIP_HERO_IDLE),
+        .isJumping = false,
+        .jumpTime = 0.0f,
+        .health = 10,
+        .score = 0,
+    };
+    return player;
+}
+
+const char* MapFileFor(Difficulty difficulty)
+{
+    switch (difficulty) {
+        case EASY: return "easy.tmx";
+        case HARD: return "hard.tmx";
+        default: return "normal.tmx"; // You can create a medium difficulty map
+    }
+}
+
+int ScoreGoalFor(Difficulty difficulty)
+{
+    switch (difficulty) {
+        case EASY: return 8;
+        case HARD: return 25;
+        default: return 12;
+    }
+}
+
+// Drop the level's map and everything read from it
+void UnloadLevel()
+{
+    if (level.map != nullptr) {
+        UnloadTMX(level.map);
+    }
+    level.map = nullptr;
+    level.mapFile = nullptr;
+    level.spikes.clear();
+    level.fallingPlats.clear();
+    ReleaseAssetScope(SCOPE_LEVEL);
+}
+
+// Start loading 'mapFile' in the background unless it's already resident or loading. Only one worker runs at a time
+// since raylib's file helpers (GetWorkingDirectory() and friends) return shared static buffers. Returns whether the
+// map is resident or being loaded.
+bool PreloadMap(const char *mapFile)
+{
+    if ((level.map != nullptr && strcmp(level.mapFile, mapFile) == 0) || mapLoads.count(mapFile) > 0) {
+        return true;
+    }
+    for (auto &entry : mapLoads) {
+        MapLoad &load = entry.second;
+        if (load.worker.valid() && load.worker.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+    }
+    MapLoad load = {};
+    load.worker = std::async(std::launch::async, LoadTMXDeferred, mapFile);
+    mapLoads.emplace(mapFile, std::move(load));
+    return true;
+}
+
+// Move the background load of 'mapFile' along, uploading up to 'budget' textures once the worker is done.
+// Returns its progress from 0 to 1, counting the worker as one step and each texture as another. Maps that aren't
+// being loaded in the background count as done.
+float UpdateMapLoad(const char *mapFile, uint32_t budget)
+{
+    auto it = mapLoads.find(mapFile);
+    if (it == mapLoads.end()) {
+        return 1.0f;
+    }
+    MapLoad &load = it->second;
+    if (load.worker.valid()) {
+        if (load.worker.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return 0.0f;
+        }
+        load.map = load.worker.get();
+        load.texturesTotal = load.texturesLeft = UploadTexturesTMX(load.map, 0);
+    }
+    if (load.texturesLeft > 0) {
+        load.texturesLeft = UploadTexturesTMX(load.map, budget);
+    }
+    return (1.0f + load.texturesTotal - load.texturesLeft) / (1.0f + load.texturesTotal);
+}
+
+// Take the map 'mapFile' was being loaded into, waiting for the worker and uploading whatever is left if it isn't
+// done yet. Returns nullptr if the map wasn't being loaded in the background or loading it failed.
+TmxMap* TakeLoadedMap(const char *mapFile)
+{
+    auto it = mapLoads.find(mapFile);
+    if (it == mapLoads.end()) {
+        return nullptr;
+    }
+    if (it->second.worker.valid()) {
+        it->second.worker.wait();
+    }
+    UpdateMapLoad(mapFile, UINT32_MAX);
+    TmxMap *map = it->second.map;
+    mapLoads.erase(it);
+    return map;
+}
+
+// Wait out and drop every background load that was never taken
+void UnloadMapLoads()
+{
+    for (auto &entry : mapLoads) {
+        MapLoad &load = entry.second;
+        TmxMap *map = load.worker.valid() ? load.worker.get() : load.map;
+        if (map != nullptr) {
+            UnloadTMX(map);
+        }
+    }
+    mapLoads.clear();
+}
+
+// Make 'mapFile' the resident level, loading it only if it isn't already. Everything derived from the map alone
+// (atlas remapping, baked tile layers, collision index, starting layout) is built here once, never per run.
+bool LoadLevelMap(const char *mapFile)
+{
+    if (level.map != nullptr && strcmp(level.mapFile, mapFile) == 0) {
+        return true;
+    }
+    UnloadLevel();
+
+    // Adopt the map if it was loaded in the background. Otherwise load it here, parsing the TMX only when its
+    // compiled .tmxb copy is missing or stale.
+    TmxMap *map = TakeLoadedMap(mapFile);
+    if (map == nullptr) {
+        map = LoadTMXCached(mapFile);
+    }
+    // Maps preloaded for the difficulties that weren't picked won't be needed. Their workers are done by now since
+    // the chosen map's only started once they were (see PreloadMap).
+    UnloadMapLoads();
+    if (map == nullptr) {
+        TraceLog(LOG_ERROR, "Couldn't load the map: %s", mapFile);
+        return false;
+    }
+    RemapTilesToAtlas(map, &atlas);
+    BakeTMX(map);
+    BuildCollisionIndex(map, &collisionIndex);
+    maxEnemies = GetMapIntProperty(map, "maxEnemies", 20);
+    LoadSpikesFromTMX(map, &level.spikes);
+    LoadFallingPlat(map, &level.fallingPlats);
+
+    level.map = map;
+    level.mapFile = mapFile;
+    TraceLogAssets(LOG_INFO);
+    return true;
+}
+
+// Put everything a run changes back to how the level starts: entities, orbs, player, camera, sim timers and tile
+// animations. Touches neither the disk nor the GPU.
+void ResetLevel(SimState *sim)
+{
+    clearEnemies();
+    spikes.clear();
+    falling_Plat.clear();
+    sim->orbs->clear();
+    spawnedPlatforms.clear();
+    gridClear(&entityGrid);
+    ResetAnimationsTMX(level.map);
+
+    // Reset player and camera
+    ResetPlayer(sim->player, level.mapFile);
+    ResetCameraFollow(sim->camera, sim->player);
+    ResetCamera(sim->camera, sim->player);
+
+    for (Spike spike : level.spikes) {
+        spike.gridId = gridInsert(&entityGrid, spike.rect, ENT_SPIKE, (int)spikes.size());
+        spikes.push_back(spike);
+    }
+    for (fallingPlat platform : level.fallingPlats) {
+        platform.gridId = gridInsert(&entityGrid, platform.rect, ENT_FALLING_PLAT, (int)falling_Plat.size());
+        falling_Plat.push_back(platform);
+    }
+
+    sim->map = level.map;
+    sim->prevCameraTarget = sim->camera->target;
+    sim->accumulator = 0.0f; // The last run's partial step doesn't carry into this one
+    sim->input = {};
+    sim->transition->active = false;
+    sim->transition->alpha = 0.0f;
+    sim->transition->timer = 0.0f;
+    sim->enemySpawnTimer = 0.0f;
+    sim->enemySpawnInterval = 2.0f;
+}
+
+// (Re)start a level. Restarting the resident level only resets the run; a different one is loaded first.
+// Returns the level's map, or nullptr if it couldn't be loaded.
+TmxMap* LoadLevel(SimState *sim, const char *mapFile)
+{
+    if (!LoadLevelMap(mapFile)) {
+        sim->map = nullptr;
+        return nullptr;
+    }
+    ResetLevel(sim);
+    return level.map;
+}
+
+// Scripted stand-in for the keyboard in headless runs: walks one way for a while, then the other,
+// tapping or holding jump at random
+struct BotInput {
+    int moveSteps;  // Steps left before picking a new direction
+    int dir;        // -1 left, 0 idle, 1 right
+    int jumpSteps;  // Steps left to keep jump held
+};
+
+void updateBotInput(BotInput *bot, SimInput *input)
+{
+    if (--bot->moveSteps <= 0) {
+        bot->dir = GetRandomValue(-1, 1);
+        bot->moveSteps = GetRandomValue(30, 240);
+    }
+    bool wasDown = input->jumpDown;
+    if (bot->jumpSteps > 0) {
+        bot->jumpSteps--;
+    } else if (GetRandomValue(0, 90) == 0) {
+        bot->jumpSteps = GetRandomValue(1, (int)(MAX_JUMP_HOLD / SIM_DT));
+    }
+
+    input->left = bot->dir < 0;
+    input->right = bot->dir > 0;
+    input->jumpDown = bot->jumpSteps > 0;
+    input->jumpPressed = input->jumpDown && !wasDown;
+    input->jumpReleased = !input->jumpDown && wasDown;
+}
+
+// Simulate 'runs' plays of a map as fast as the CPU allows, with no window, rendering or audio
+int RunHeadless(Difficulty difficulty, int runs, int maxSteps, unsigned int seed)
+{
+    headless = true;
+    SetTextureLoadingTMX(false);
+    SetTraceLogLevel(LOG_WARNING);
+
+    const char *mapFile = MapFileFor(difficulty);
+    int scoreGoal = ScoreGoalFor(difficulty);
+
+    TmxMap *map = nullptr;
+    Player player = CreatePlayer(AtlasSprite{});
+    Camera2D camera = { .offset = {W / 2.0f, H / 2.0f}, .target = {W / 2.0f, H / 2.0f}, .rotation = 0.0f, .zoom = 1.0f };
+    std::vector<Score_Orb> orbs;
+    DeathTransition deathTransition = {false, 0.0f, 0.0f};
+    SimState sim = {
+        .dt = SIM_DT,
+        .time = 0.0,
+        .accumulator = 0.0f,
+        .input = {},
+        .map = nullptr,
+        .player = &player,
+        .camera = &camera,
+        .prevCameraTarget = camera.target,
+        .orbs = &orbs,
+        .transition = &deathTransition,
+        .enemySpawnTimer = 0.0f,
+        .enemySpawnInterval = 2.0f,
+    };
+
+    int wins = 0, deaths = 0, timeouts = 0;
+    long long totalSteps = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int run = 0; run < runs; run++) {
+        SetRandomSeed(seed + run);
+        srand(seed + run);
+        map = LoadLevel(&sim, mapFile);
+        if (map == nullptr) {
+            return EXIT_FAILURE;
+        }
+
+        BotInput bot = {};
+        int steps = 0;
+        for (; steps < maxSteps; steps++) {
+            updateBotInput(&bot, &sim.input);
+            stepGameplay(&sim);
+            if (player.health <= 0 || player.state == DEAD || deathTransition.active) {
+                deaths++;
+                break;
+            }
+            if (player.score >= scoreGoal) {
+                wins++;
+                break;
+            }
+        }
+        if (steps == maxSteps) {
+            timeouts++;
+        }
+        totalSteps += steps;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%s: %d runs, %d wins, %d deaths, %d timeouts\n", mapFile, runs, wins, deaths, timeouts);
+    printf("%lld steps (%.1f sim minutes) in %.3fs, %.0f steps/s\n", totalSteps, totalSteps * SIM_DT / 60.0,
+        seconds, seconds > 0.0 ? totalSteps / seconds : 0.0);
+
+    UnloadLevel();
+    UnloadParseBuffersTMX();
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    // --headless [--map easy|normal|hard] [--runs N] [--steps N] [--seed N]
+    bool runHeadless = false;
+    Difficulty headlessDifficulty = NORMAL;
+    int headlessRuns = 100;
+    int headlessSteps = (int)(5 * 60 / SIM_DT); // Give up on a run after five simulated minutes
+    unsigned int headlessSeed = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless") {
+            runHeadless = true;
+        } else if (arg == "--map" && hasValue) {
+            std::string name = argv[++i];
+            headlessDifficulty = name == "easy" ? EASY : name == "hard" ? HARD : NORMAL;
+        } else if (arg == "--runs" && hasValue) {
+            headlessRuns = atoi(argv[++i]);
+        } else if (arg == "--steps" && hasValue) {
+            headlessSteps = atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            headlessSeed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        }
+    }
+    if (runHeadless) {
+        return RunHeadless(headlessDifficulty, headlessRuns, headlessSteps, headlessSeed);
+    }
 
-int main() {
     InitWindow(W, H, "Bullet Jumper");
     SetTargetFPS(60);
+    // Tile layers are baked by LoadLevelMap, once their tiles draw from the atlas
+    SetTileLayerBakingTMX(false);
     
     // Initialize audio device
     InitAudioDevice();
@@ -1089,31 +2376,13 @@ int main() {
     
     TmxMap* map = nullptr;
     
-    Texture2D hero = LoadTexture("assets/herochar-sprites/herochar_spritesheet.png");
-    Texture2D floorText = LoadTexture("assets/tiles-and-background-foreground/floor.png");
-    Texture2D fallinText = LoadTexture("assets/tiles-and-background-foreground/falling.png");
-    Texture2D enemyText = LoadTexture("assets/herochar-sprites/fly-eye.png");
+    BuildTextureAtlas(&atlas, ATLAS_IMAGES, sizeof(ATLAS_IMAGES) / sizeof(ATLAS_IMAGES[0]));
+    AtlasSprite hero = AcquireSprite("assets/herochar-sprites/herochar_spritesheet.png", SCOPE_SESSION);
+    AtlasSprite floorText = AcquireSprite("assets/tiles-and-background-foreground/floor.png", SCOPE_SESSION);
+    AtlasSprite fallinText = AcquireSprite("assets/tiles-and-background-foreground/falling.png", SCOPE_SESSION);
+    AtlasSprite enemyText = AcquireSprite("assets/herochar-sprites/fly-eye.png", SCOPE_SESSION);
 
-    Player player = {
-        .rect = {0, 1700, 64.0f, 64.0f},
-        .vel = {0.0f, 0.0f},
-        .sprite = hero,
-        .dir = RIGHT,
-        .state = IDLE,
-        .animations = {
-            {0, 7, 0, 0, 16, 16, 0.1f, 0.1f, ONESHOT},
-            {0, 5, 0, 1, 16, 16, 0.1f, 0.1f, REPEATING},
-            {0, 3, 0, 5, 16, 16, 0.1f, 0.1f, REPEATING},
-            {0, 2, 0, 9, 16, 16, 0.1f, 0.1f, REPEATING},
-            {0, 2, 0, 7, 16, 16, 0.1f, 0.1f, REPEATING},
-            {0, 2, 0, 6, 16, 16, 0.1f, 0.1f, REPEATING},
-            {0, 3, 0, 8, 16, 16, 0.1f, 0.1f, REPEATING}
-        },
-        .isJumping = false,
-        .jumpTime = 0.0f,
-        .health = 10,
-        .score = 0,
-    };
+    Player player = CreatePlayer(hero);
 
 
     Camera2D camera = {
@@ -1128,21 +2397,37 @@ int main() {
     Rectangle killbox = {0, 0, (float)W, 100}; 
 
     std::vector<Score_Orb> orbs;
-    static bool spikesLoaded = false;
-    static bool fallingPlatLoaded = false;
-    static bool orbsSpawned = false;
-    static bool enemiesSpawned = false;
     int scoreGoal = 10;  // Default score goal
 
-    // Variables needed for gameplay (moved outside switch statements)
-    float maxFallDistance = 500.0f; // Maximum distance player can fall below camera
-    float bottomOfScreen = 0.0f;
     Color killboxColor = {255, 0, 0, 128}; // Semi-transparent red
     
     // Initialize death transition
     DeathTransition deathTransition = {false, 0.0f, 0.0f};
+
+    SimState sim = {
+        .dt = SIM_DT,
+        .time = 0.0,
+        .accumulator = 0.0f,
+        .input = {},
+        .map = nullptr,
+        .player = &player,
+        .camera = &camera,
+        .prevCameraTarget = camera.target,
+        .orbs = &orbs,
+        .transition = &deathTransition,
+        .enemySpawnTimer = 0.0f,
+        .enemySpawnInterval = 2.0f, // Start with a 2-second interval
+    };
+    float loadProgress = 0.0f;  // Of the selected map's background load, shown while LOADING
     
     while (!WindowShouldClose()) {
+        // Clamp long frames (window drags, breakpoints) so the sim doesn't spiral trying to catch up
+        float frameTime = fminf(GetFrameTime(), MAX_FRAME_TIME);
+        if (IsKeyPressed(KEY_F3)) {
+            showRenderStats = !showRenderStats;
+        }
+
+
         // Handle game state logic
         switch(gameState) {
             case MENU:
@@ -1166,28 +2451,24 @@ int main() {
                     // Play menu selection sound
                     PlaySound(menuSelectSound);
                     // Update map file based on difficulty
-                    switch(difficulty) {
-                        case EASY: mapFile = "easy.tmx"; break;
-                        case NORMAL: mapFile = "normal.tmx"; break; // You can create a medium difficulty map
-                        case HARD: mapFile = "hard.tmx"; break;
-                    }
+                    mapFile = MapFileFor(difficulty);
                 }
                 if (menuSelection == 1 && IsKeyPressed(KEY_LEFT)) {
                     difficulty = static_cast<Difficulty>((static_cast<int>(difficulty) + 2) % 3);
                     // Play menu selection sound
                     PlaySound(menuSelectSound);
                     // Update map file based on difficulty
-                    switch(difficulty) {
-                        case EASY: mapFile = "easy.tmx";  break;
-                        case NORMAL: mapFile = "normal.tmx";  break; // You can create a medium difficulty map
-                        case HARD: mapFile = "hard.tmx";  break;
-                    }
+                    mapFile = MapFileFor(difficulty);
                 }
                 
                 // Menu navigation
                 if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_UP)) {
                     PlaySound(menuSelectSound);
                 }
+
+                // Load the selected difficulty's map in the background while the player is still choosing
+                PreloadMap(mapFile);
+                loadProgress = UpdateMapLoad(mapFile, TEXTURE_UPLOAD_BUDGET);
                 
                 // Start game
                 if (IsKeyPressed(KEY_ENTER) && menuSelection == 0) {
@@ -1196,44 +2477,22 @@ int main() {
     
                     // Stop menu music
                     StopMusicStream(menuMusic);
+
+                    scoreGoal = ScoreGoalFor(difficulty);
                     
-                    // Ensure the previous map is fully unloaded before loading a new one
-                    if (map != nullptr) {
-                        UnloadTMX(map);
-                        map = nullptr;
-                    }
-                
-                    // Clear all game objects before loading a new map
-                    enemies.clear();
-                    spikes.clear();
-                    falling_Plat.clear();
-                    platforms.clear();
-                    orbs.clear();
-                    spawnedPlatforms.clear();
-
-                    switch (difficulty) {
-                        case EASY: scoreGoal = 8; break;
-                        case NORMAL: scoreGoal = 12; break;
-                        case HARD: scoreGoal = 25; break;
-                    }
-                    
-                    // Load the selected map
-                    map = LoadTMX(mapFile);
+                    // Start once the selected map has finished loading
+                    gameState = LOADING;
+                }
+                break;
+
+            case LOADING:
+                // The map may still be waiting on a worker started for another difficulty
+                loadProgress = PreloadMap(mapFile) ? UpdateMapLoad(mapFile, TEXTURE_UPLOAD_BUDGET) : 0.0f;
+                if (loadProgress >= 1.0f) {
+                    map = LoadLevel(&sim, mapFile);
                     if (map == nullptr) {
-                        TraceLog(LOG_ERROR, "Couldn't load the map: %s", mapFile);
                         return EXIT_FAILURE;
                     }
-                
-                    // Reset player and game state
-                    ResetPlayer(&player, mapFile);
-                    ResetCameraFollow(&camera, &player);
-                    ResetCamera(&camera, &player);
-                
-                    spikesLoaded = false;
-                    fallingPlatLoaded = false;
-                    orbsSpawned = false;
-                    enemiesSpawned = false;
-                
                     gameState = GAMEPLAY;
                 }
                 break;
@@ -1242,7 +2501,7 @@ int main() {
                 // Check if player is dead
                 if (player.health <= 0 || player.state == DEAD) {
                     // Only transition to game over if death transition is complete
-                    if (!deathTransition.active || updateDeathTransition(&deathTransition)) {
+                    if (!deathTransition.active || updateDeathTransition(&deathTransition, frameTime)) {
                         gameState = GAME_OVER;
                         break;
                     }
@@ -1256,57 +2515,17 @@ int main() {
                 // Only update gameplay if not in death transition
                 if (!deathTransition.active) {
                     AnimateTMX(map);
-                    movePlayer(&player);
-                    applyGravity(&(player.vel));
-                    enemySpawnTimer -= GetFrameTime();
-                    if (enemySpawnTimer <= 0 && enemies.size() < 20) {  // Increase limit if needed
-                        int numEnemies = GetRandomValue(1, 5);  // Spawn 1-3 enemies
-                        for (int i = 0; i < numEnemies; i++) {
-                            spawnEnemy(camera, enemyText);  // Use camera for positioning
-                        }
-                
-                        enemySpawnInterval = GetRandomValue(1, 2);
-                        enemySpawnTimer = enemySpawnInterval;
-                    }
-                    for (size_t i = 0; i < falling_Plat.size(); i++){
-                        applyGravity(&falling_Plat[i].vel);
-                        movePlatByVel(&falling_Plat[i].rect, &falling_Plat[i].vel, falling_Plat[i].isFalling);
-                    }
-                    
-                    moveRectByVel(&(player.rect), &(player.vel));
-                    checkTileCollisions(map, &player);
-                    checkSpikeCol(&player, &deathTransition);
-                    update_animation(&(player.animations[player.state]));
-                    for (size_t i = 0; i < enemies.size(); i++){
-                        update_animation(&(enemies[i].animations[enemies[i].e_state]));
-                    }
-                
-                    hitCheck(&player, &deathTransition);
-                    cameraFollow(&camera, &player);
-                    
-                    UpdateSpikes(&player);
-                    updateFallingPlat(&player);
-                    checkOrbCollection(&player, orbs);
+                    sampleInput(&sim.input);
 
-                    
-                    // Check horizontal boundaries
-                    checkHorizontalBoundaries(&player, map, &deathTransition);
-                    
-                    // Add a secondary check for falling too far below the camera view
-                    bottomOfScreen = camera.target.y + (H / 2.0f) / camera.zoom;
-                    if (player.rect.y > bottomOfScreen + maxFallDistance && !deathTransition.active) {
-                        player.health = 0;
-                        player.state = DEAD;
-                        deathTransition.active = true;
-                        deathTransition.alpha = 0.0f;
-                        deathTransition.timer = 0.0f;
-                        // Play death sound
-                        PlaySound(deathSound);
-                        TraceLog(LOG_INFO, "Player fell too far below the screen!");
+                    // Run as many fixed steps as the elapsed time covers, the remainder carries over
+                    sim.accumulator += frameTime;
+                    while (sim.accumulator >= SIM_DT && !deathTransition.active) {
+                        stepGameplay(&sim);
+                        sim.accumulator -= SIM_DT;
                     }
                 } else {
                     // Update death transition
-                    updateDeathTransition(&deathTransition);
+                    updateDeathTransition(&deathTransition, frameTime);
                 }
                 break;
                 
@@ -1317,39 +2536,14 @@ int main() {
                 // Handle game over inputs
                 if (IsKeyPressed(KEY_ENTER)) {
                     // Play game start sound
-                    
                     PlaySound(gameStartSound);
                     
-                    if (map != nullptr) {
-                        UnloadTMX(map);
-                        map = nullptr;
-                    }
-                
-                    // Clear all objects before restarting
-                    enemies.clear();
-                    spikes.clear();
-                    falling_Plat.clear();
-                    platforms.clear();
-                    orbs.clear();
-                    spawnedPlatforms.clear();
-                
                     // Load the same map again
-                    map = LoadTMX(mapFile);
+                    map = LoadLevel(&sim, mapFile);
                     if (map == nullptr) {
-                        TraceLog(LOG_ERROR, "Couldn't load the map: %s", mapFile);
                         return EXIT_FAILURE;
                     }
                 
-                    // Reset player and camera
-                    ResetPlayer(&player, mapFile);
-                    ResetCameraFollow(&camera, &player);
-                    ResetCamera(&camera, &player);
-                    
-                    spikesLoaded = false;
-                    fallingPlatLoaded = false;
-                    orbsSpawned = false;
-                    enemiesSpawned = false;
-                
                     gameState = GAMEPLAY;
                 }
                 else if (IsKeyPressed(KEY_M)) {
@@ -1369,36 +2563,12 @@ int main() {
                 if (IsKeyPressed(KEY_ENTER)) {
                     PlaySound(gameStartSound);
 
-                    if (map != nullptr) {
-                        UnloadTMX(map);
-                        map = nullptr;
-                    }
-
-                    // Clear game objects before restarting
-                    enemies.clear();
-                    spikes.clear();
-                    falling_Plat.clear();
-                    platforms.clear();
-                    orbs.clear();
-                    spawnedPlatforms.clear();
-
                     // Reload the level
-                    map = LoadTMX(mapFile);
+                    map = LoadLevel(&sim, mapFile);
                     if (map == nullptr) {
-                        TraceLog(LOG_ERROR, "Couldn't load the map: %s", mapFile);
                         return EXIT_FAILURE;
                     }
 
-                    // Reset player and camera
-                    ResetPlayer(&player, mapFile);
-                    ResetCameraFollow(&camera, &player);
-                    ResetCamera(&camera, &player);
-
-                    spikesLoaded = false;
-                    fallingPlatLoaded = false;
-                    orbsSpawned = false;
-                    enemiesSpawned = false;
-
                     gameState = GAMEPLAY;
                 }
                 else if (IsKeyPressed(KEY_M)) {
@@ -1417,34 +2587,35 @@ int main() {
             case MENU:
                 DrawMainMenu(menuSelection, difficulty);
                 break;
+
+            case LOADING:
+                DrawLoadingScreen(loadProgress);
+                break;
                 
-            case GAMEPLAY:
-                BeginMode2D(camera);
-                DrawTMX(map, &camera, 0, 0, WHITE);
+            case GAMEPLAY: {
+                // Draw between the last two sim steps by how far the accumulator has run into the next one
+                float alpha = sim.accumulator / SIM_DT;
+                Camera2D renderCamera = camera;
+                renderCamera.target.x = sim.prevCameraTarget.x + (camera.target.x - sim.prevCameraTarget.x) * alpha;
+                renderCamera.target.y = sim.prevCameraTarget.y + (camera.target.y - sim.prevCameraTarget.y) * alpha;
+
+                Rectangle view = cameraView(&renderCamera, CULL_MARGIN);
+                cullStats = {};
+                spriteBatch.quadsDrawn = spriteBatch.textureSwitches = 0;
+
+                BeginMode2D(renderCamera);
+                DrawTMX(map, &renderCamera, 0, 0, WHITE);
                 
 
-                DrawSpikes(); 
-                drawFallingPlat(fallinText);
-                drawSolidPlat(floorText);
-                drawPlayer(&player);
-
-                if (!orbsSpawned){
-                    spawnOrb(map, camera, orbs);
-                    //orbsSpawned = true;
-                }
-                
+                DrawSpikes(view); 
+                drawFallingPlat(fallinText, alpha, view);
+                drawSolidPlat(floorText, view);
+                drawPlayer(&player, alpha);
+                flushSprites(&spriteBatch);
+                // Orbs go between the player and the enemies, so the enemies get a flush of their own
                 drawOrbs(orbs);
-                if (!spikesLoaded) {
-                    LoadSpikesFromTMX(map, &player);
-                    spikesLoaded = true; // Ensure spikes are only loaded once
-                }
-                if (!fallingPlatLoaded){
-                    LoadFallingPlat(map);
-                    fallingPlatLoaded = true;
-                }
-                drawEnemy();
-                
-                moveEnemy(map);
+                drawEnemy(enemyText, alpha, view);
+                flushSprites(&spriteBatch);
                 EndMode2D();
                 drawScore(player.score);
                 drawHealth(player.health);
@@ -1453,6 +2624,7 @@ int main() {
                 // Draw death transition effect on top of everything
                 drawDeathTransition(&deathTransition);
                 break;
+            }
                 
             case GAME_OVER:
                 DrawGameOver(player.score);
@@ -1464,19 +2636,19 @@ int main() {
         }
         
         DrawFPS(5, 5);
+        if (showRenderStats && gameState == GAMEPLAY) {
+            drawRenderStats();
+        }
         EndDrawing();
     }
 
-    if (map != nullptr) {
-        UnloadTMX(map);
-    }
-    UnloadTexture(hero);
-    UnloadTexture(fallinText);
-    UnloadTexture(floorText);
-    UnloadTexture(enemyText);
-
+    UnloadMapLoads();
+    UnloadLevel();
+    UnloadParseBuffersTMX(); // raytmx keeps the buffers it parsed the maps with for the next load until now
     // Unload all game sounds
     UnloadGameSounds();
+    ReleaseAssetScope(SCOPE_SESSION);
+    UnloadTextureAtlas(&atlas);
 
     // Close audio device
     CloseAudioDevice();
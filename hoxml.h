@@ -25,6 +25,11 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
     #define HOXML_DECL extern
   to specify hoxml function declarations as static or extern, respectively.
   The default specifier is extern.
+
+  Runs of plain ASCII character data are scanned 16 bytes at a time with SSE2, or 32 with AVX2 when the compiler
+  targets it (e.g. -mavx2), and copied in bulk. Define
+    #define HOXML_NO_SIMD
+  before the implementation to scan them one byte at a time instead.
 */
 
 #ifndef HOXML_H
@@ -64,9 +69,19 @@ typedef enum {
     HOXML_ELEMENT_END, /**< An element was closed, </tag> or <tag/>, and its name and content are available. */
     HOXML_ATTRIBUTE, /**< An attribute's value, its name, and its element are available. */
     HOXML_PROCESSING_INSTRUCTION_BEGIN, /**< A processing instruction began and its target is available. */
-    HOXML_PROCESSING_INSTRUCTION_END /**< A processing instruction ended and its content is available. */
+    HOXML_PROCESSING_INSTRUCTION_END, /**< A processing instruction ended and its content is available. */
+    HOXML_CONTENT_CHUNK /**< Part of the open element's content is available. See 'content_chunk_length'. */
 } hoxml_code_t;
 
+/**
+ * Flags for the context's 'views' field. Each allows one kind of string to be handed over as a view of the XML content
+ * rather than a copy of it.
+ */
+enum {
+    HOXML_VIEW_VALUE = 0x01, /**< Attribute values may be views. */
+    HOXML_VIEW_CONTENT = 0x02 /**< Element content may be views. */
+};
+
 /**
  * Holds context and state information needed by hoxml. Some of this information is public and holds the data parsed
  * from XML content (element names, attribute names and values, etc.) but some is private and only makes sense to hoxml.
@@ -79,6 +94,12 @@ typedef struct {
     char* content; /**< Holds the current element's content. This means all character data found, including spaces. */
     uint32_t line; /**< The line currently being parsed. Lines are determined by line feeds and carriage returns. */
     uint32_t column; /**< The column, on the current line, of the character last parsed. */
+    size_t content_chunk_length; /**< If nonzero, content is handed over in HOXML_CONTENT_CHUNK pieces this long. */
+    const char* value_view; /**< Points to the current attribute's value, copied or not. See 'views'. */
+    size_t value_length; /**< Length, in bytes, of the string 'value_view' points to. */
+    const char* content_view; /**< Points to the element content being handed over, copied or not. See 'views'. */
+    size_t content_length; /**< Length, in bytes, of the string 'content_view' points to. */
+    uint8_t views; /**< Any of the HOXML_VIEW_* flags. Strings are always copied when this is zero. */
 
     /* Private (for internal use) */
     uint8_t is_initialized; /* Set to true by hoxml_init() and indicates this context is safe to use */
@@ -90,6 +111,8 @@ typedef struct {
     size_t buffer_length; /* Amount of memory allocated for hoxml */
     char* reference_start; /* Pointer to a location on the stack where a reference entity string (e.g "&lt;") began */
     char* stack; /* Pointer to the current node in the stack-like structure of elements */
+    const char* view; /* Character data parsed, but not copied, from the XML content. See hoxml_append_view(). */
+    size_t view_length; /* Length of the 'view' character data in bytes */
     int8_t state; /* Current parsing state, determines which characters are acceptable and when to return */
     int8_t post_state; /* When not "none" this indicates a past state that has a cleanup step */
     int8_t return_state; /* State to return to after the processing of a comment or reference has finished */
@@ -127,8 +150,22 @@ HOXML_DECL void hoxml_realloc(hoxml_context_t* context, char* buffer, size_t buf
  * parses up to the indicated length of the content, HOXML_ERROR_UNEXPECTED_EOF is returned and parsing will cease.
  * However, this error is recoverable and parsing will continue if the next call to hoxml_parse() passes a new XML
  * content string, using the same pointer or not.
+ * Likewise, an element's content doesn't need to be held in its entirety. If the context's 'content_chunk_length' is
+ * set, which may be done between any two calls, HOXML_CONTENT_CHUNK is returned each time an open element's content
+ * reaches that many bytes (counting its tag). The content is then dropped from the buffer on the next call and
+ * HOXML_ELEMENT_END only has whatever came after the last chunk. Together, these keep memory use down to the
+ * element stack no matter how large the document is.
+ * By default, attribute values and element content are copied to the buffer and null terminated. Setting the
+ * context's 'views' field, which may also be done between any two calls, lets them be left where they are instead.
+ * With HOXML_ATTRIBUTE, 'value_view' and 'value_length' then point into the XML content string for values with no
+ * character or entity references, and 'value' is NULL. Likewise, 'content_view' and 'content_length' do for element
+ * content with HOXML_ELEMENT_END and HOXML_CONTENT_CHUNK, and 'content' is NULL. Content with references or child
+ * elements is still copied, as is anything split between two XML content strings, though a content chunk is handed
+ * over early instead when the XML content string runs out. Views are not null terminated and are only valid until
+ * the next call. Whenever a string is copied, views enabled or not, 'value_view' or 'content_view' points to the copy.
  *
- * @param context An initialized hoxml context object. This should be treated as read-only until parsing is done.
+ * @param context An initialized hoxml context object. This should be treated as read-only until parsing is done,
+ * except for 'content_chunk_length' and 'views'.
  * @param xml XML content as a string.
  * @param xml_length Length of the XML content in bytes.
  * @return A code indicating what information from the XML content is available or an error.
@@ -206,6 +243,7 @@ enum {
     /* Post (i.e. after) parser states indicating actions to take on the next call to hoxml_parse() */
     HOXML_POST_STATE_TAG_END,
     HOXML_POST_STATE_ATTRIBUTE_END,
+    HOXML_POST_STATE_CONTENT_CHUNK,
 };
 
 enum {
@@ -214,7 +252,8 @@ enum {
     HOXML_FLAG_PROCESSING_INSTRUCTION = 0x04, /* 0000 0100 - the node is a processing instruction */
     HOXML_FLAG_DOUBLE_QUOTE = 0x08, /* 0000 1000 - the value string being parsed was opened with a double quote (") */
     HOXML_FLAG_TERMINATED = 0x10, /* 0001 0000 - the node's current string (tag, attribute, etc.) is null terminated */
-    HOXML_FLAG_BEGUN = 0x20 /* 0010 0000 - the "element begun" code was already returned for this node */
+    HOXML_FLAG_BEGUN = 0x20, /* 0010 0000 - the "element begun" code was already returned for this node */
+    HOXML_FLAG_COPIED = 0x40 /* 0100 0000 - some of the current value or content was copied, so it can't be a view */
 };
 
 enum {
@@ -266,11 +305,35 @@ typedef struct {
 #define HOXML_IS_HEX_CHAR(c) (HOXML_IS_NUMERIC(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
 #define HOXML_IS_VALUE_CHAR_DATA(f, c) (HOXML_IS_CHAR_DATA(c) && ((f & HOXML_FLAG_DOUBLE_QUOTE && c != '"') || \
     c != '\''))
+/* ASCII character data that can be copied without any further thought, see hoxml_append_run() */
+#define HOXML_IS_PLAIN_CHAR_DATA(c) (c > 0x00 && c < 0x80 && HOXML_IS_CHAR_DATA(c) && c != '"' && c != '\'' && \
+    !HOXML_IS_NEW_LINE(c))
+
+#if !defined(HOXML_NO_SIMD) && defined(__AVX2__)
+    #include <immintrin.h> /* AVX2 intrinsics */
+    #define HOXML_AVX2
+#elif !defined(HOXML_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h> /* SSE2 intrinsics */
+    #define HOXML_SSE2
+#endif
+#if (defined(HOXML_AVX2) || defined(HOXML_SSE2)) && defined(_MSC_VER)
+    #include <intrin.h> /* _BitScanForward() */
+#endif
 
 void hoxml_push_stack(hoxml_context_t* context);
 void hoxml_pop_stack(hoxml_context_t* context);
 void hoxml_append_character(hoxml_context_t* context, hoxml_character_t c);
 void hoxml_append_terminator(hoxml_context_t* context);
+void hoxml_append_run(hoxml_context_t* context);
+void hoxml_append_view(hoxml_context_t* context, hoxml_character_t c, const char* start);
+void hoxml_copy_view(hoxml_context_t* context);
+uint8_t hoxml_is_viewable(hoxml_context_t* context);
+uint8_t hoxml_is_end_tag_ahead(hoxml_context_t* context);
+hoxml_code_t hoxml_content_chunk(hoxml_context_t* context);
+size_t hoxml_scan_run(const char* str, size_t length);
+#if defined(HOXML_AVX2) || defined(HOXML_SSE2)
+uint32_t hoxml_lowest_bit(uint32_t mask);
+#endif
 void hoxml_end_reference(hoxml_context_t* context, uint8_t type);
 void hoxml_begin_tag(hoxml_context_t* context);
 hoxml_code_t hoxml_end_tag(hoxml_context_t* context);
@@ -316,6 +379,10 @@ HOXML_DECL void hoxml_realloc(hoxml_context_t* context, char* buffer, const size
     }
 
     /* Use offsets from the original buffer pointer to reassign pointers such that they now point to the new buffer */
+    if (context->value_view != NULL && context->value_view == context->value) /* Copies, not views, move too */
+        context->value_view = buffer + (context->value - context->buffer);
+    if (context->content_view != NULL && context->content_view == context->content)
+        context->content_view = buffer + (context->content - context->buffer);
     if (context->tag != NULL)
         context->tag = buffer + ((char*)context->tag - context->buffer);
     if (context->attribute != NULL)
@@ -362,7 +429,9 @@ HOXML_DECL hoxml_code_t hoxml_parse(hoxml_context_t* context, const char* xml, c
                 return HOXML_ERROR_UNEXPECTED_EOF;
             context->state = context->error_return_state;
             context->error_return_state = HOXML_STATE_NONE;
-            /* Note: there is a check for a change in the input pointer a little further down */
+            /* The string is new even if its pointer isn't, e.g. a buffer refilled with the next part of a file, so */
+            /* forget the old one. This makes the check for a change in the input pointer a little further down pass. */
+            context->xml = NULL;
         } break;
         case HOXML_STATE_DONE: return HOXML_END_OF_DOCUMENT;
         case HOXML_STATE_ERROR_INTERNAL: return HOXML_ERROR_INTERNAL;
@@ -399,6 +468,11 @@ HOXML_DECL hoxml_code_t hoxml_parse(hoxml_context_t* context, const char* xml, c
             return HOXML_ERROR_INTERNAL;
         }
 
+        /* Content and attribute values are mostly long runs of characters that need nothing more than to be copied */
+        /* so they're found and copied many bytes at a time. The character ending a run is parsed as usual below. */
+        if (context->state == HOXML_STATE_OPEN_TAG || context->state == HOXML_STATE_ATTRIBUTE_VALUE)
+            hoxml_append_run(context);
+
         size_t bytes_remaining = (size_t)(context->xml_length - (context->iterator - context->xml));
         size_t bytes_to_copy = (bytes_remaining <= 4 ? bytes_remaining : 4) - context->stream_length;
         if (bytes_to_copy < 4)
@@ -410,6 +484,15 @@ HOXML_DECL hoxml_code_t hoxml_parse(hoxml_context_t* context, const char* xml, c
 
         /* If the character is the equivalent of a null terminator or there was not enough data to decode the value */
         if (c.value == 0 || c.value == UINT32_MAX) {
+            /* Character data viewed so far won't be reachable once the XML content string changes. Content being */
+            /* handed over in chunks can be handed over now, as is, but anything else has to be copied. */
+            if (context->view_length > 0) {
+                if (context->state == HOXML_STATE_OPEN_TAG && context->content_chunk_length > 0)
+                    return hoxml_content_chunk(context);
+                hoxml_copy_view(context);
+                if (context->state == HOXML_STATE_ERROR_INSUFFICIENT_MEMORY) /* Nothing was iterated, just return */
+                    return HOXML_ERROR_INSUFFICIENT_MEMORY;
+            }
             context->stream_length = bytes_to_copy;
             context->error_return_state = context->state;
             context->state = HOXML_STATE_ERROR_UNEXPECTED_EOF;
@@ -594,6 +677,7 @@ HOXML_DECL hoxml_code_t hoxml_parse(hoxml_context_t* context, const char* xml, c
                 else
                     HOXML_STACK->flags &= ~HOXML_FLAG_DOUBLE_QUOTE; /* Remove the double quote flag from this node */
                 context->value = HOXML_STACK->end + 1; /* The attribute's value string will begin here */
+                HOXML_STACK->flags &= ~HOXML_FLAG_COPIED; /* Nothing of the value has been copied yet */
             }
             else if (!HOXML_IS_WHITESPACE(c.value))
                 context->state = HOXML_STATE_ERROR_SYNTAX;
@@ -602,30 +686,62 @@ HOXML_DECL hoxml_code_t hoxml_parse(hoxml_context_t* context, const char* xml, c
             HOXML_LOG_STATE("HOXML_STATE_ATTRIBUTE_VALUE")
             if ((HOXML_STACK->flags & HOXML_FLAG_DOUBLE_QUOTE && c.value == '"') || (!(HOXML_STACK->flags &
                     HOXML_FLAG_DOUBLE_QUOTE) && c.value == '\'')) { /* The quotation marks match, value is done */
+                size_t value_length = (size_t)(HOXML_STACK->end + 1 - context->value);
                 hoxml_append_terminator(context);
                 if (context->state >= HOXML_STATE_NONE) { /* If appending the terminator was successful */
+                    if (context->view_length > 0) { /* If the value was only viewed, hand over the view */
+                        context->value_view = context->view;
+                        context->value_length = context->view_length;
+                        context->value = NULL;
+                        context->view = NULL;
+                        context->view_length = 0;
+                    } else {
+                        context->value_view = context->value;
+                        context->value_length = value_length;
+                    }
                     context->state = HOXML_STATE_ELEMENT_NAME2;
                     context->post_state = HOXML_POST_STATE_ATTRIBUTE_END; /* Clean up some attribute things next call */
                     return HOXML_ATTRIBUTE;
                 }
             } else if (c.value == '&') {
-                context->state = HOXML_STATE_REFERENCE_BEGIN;
-                context->return_state = HOXML_STATE_ATTRIBUTE_VALUE; /* Return to this attribute value state later */
+                hoxml_copy_view(context); /* The referenced character will be copied so the rest must be too */
+                if (context->state >= HOXML_STATE_NONE) { /* If copying the viewed characters was successful */
+                    HOXML_STACK->flags |= HOXML_FLAG_COPIED;
+                    context->state = HOXML_STATE_REFERENCE_BEGIN;
+                    context->return_state = HOXML_STATE_ATTRIBUTE_VALUE; /* Return to this value state later */
+                }
             } else if (HOXML_IS_VALUE_CHAR_DATA(HOXML_STACK->flags, c.value))
-                hoxml_append_character(context, c);
+                hoxml_append_view(context, c, bytes_to_iterate == c.bytes ? context->iterator - c.bytes : NULL);
             else
                 context->state = HOXML_STATE_ERROR_SYNTAX;
             break;
         case HOXML_STATE_OPEN_TAG: /* Found a '>' and now inside an open tag, looking for multiple things */
             HOXML_LOG_STATE("HOXML_STATE_OPEN_TAG")
-            if (c.value == '<')
-                hoxml_begin_tag(context);
-            else if (c.value == '&') {
-                context->state = HOXML_STATE_REFERENCE_BEGIN;
-                context->return_state = HOXML_STATE_OPEN_TAG; /* Return to this open tag state later */
-            } else if (HOXML_IS_CHAR_DATA(c.value))
-                hoxml_append_character(context, c);
-            else
+            if (c.value == '<') {
+                /* Viewed content can stay a view if this is the element's end tag. Otherwise, a child element, */
+                /* comment, etc. goes on the stack next so the content so far must be copied ahead of it. */
+                if (!hoxml_is_end_tag_ahead(context)) {
+                    hoxml_copy_view(context);
+                    if (context->state >= HOXML_STATE_NONE) /* If copying the viewed characters was successful */
+                        HOXML_STACK->flags |= HOXML_FLAG_COPIED;
+                }
+                if (context->state >= HOXML_STATE_NONE)
+                    hoxml_begin_tag(context);
+            } else if (c.value == '&') {
+                hoxml_copy_view(context); /* The referenced character will be copied so the rest must be too */
+                if (context->state >= HOXML_STATE_NONE) { /* If copying the viewed characters was successful */
+                    HOXML_STACK->flags |= HOXML_FLAG_COPIED;
+                    context->state = HOXML_STATE_REFERENCE_BEGIN;
+                    context->return_state = HOXML_STATE_OPEN_TAG; /* Return to this open tag state later */
+                }
+            } else if (HOXML_IS_CHAR_DATA(c.value)) {
+                hoxml_append_view(context, c, bytes_to_iterate == c.bytes ? context->iterator - c.bytes : NULL);
+                /* If appending the character was successful and enough content has built up to be handed over */
+                if (context->state >= HOXML_STATE_NONE && context->content_chunk_length > 0 &&
+                        (size_t)(HOXML_STACK->end - &(HOXML_STACK->tag)) + context->view_length >=
+                        context->content_chunk_length)
+                    return hoxml_content_chunk(context);
+            } else
                 context->state = HOXML_STATE_ERROR_SYNTAX;
             break;
         case HOXML_STATE_COMMENT_CDATA_OR_DTD_BEGIN: /* Found "<!", looking for a '-', '[', or 'D' */
@@ -1017,6 +1133,8 @@ void hoxml_pop_stack(hoxml_context_t* context) {
 
     /* Overwrite the memory used by this node with zeroes */
     context->tag = context->attribute = context->value = context->content = NULL; /* TODO: move somewhere else */
+    context->value_view = context->content_view = NULL;
+    context->value_length = context->content_length = 0;
     memset(popped_node, 0, popped_node->end - (char*)popped_node + 1);
 }
 
@@ -1034,6 +1152,171 @@ void hoxml_append_character(hoxml_context_t* context, hoxml_character_t c) {
     HOXML_STACK->end += c.bytes; /* Redirect the end pointer to the new end just after the appended character */
 }
 
+/* Copy the run of plain character data at the iterator to the end of the stack's current head node, all at once, */
+/* or just extend the view if it's being viewed instead. The run stops short of filling the buffer or reaching the */
+/* content chunk length so the character that does is appended, and its consequences handled, one at a time as */
+/* usual. */
+void hoxml_append_run(hoxml_context_t* context) {
+    /* UTF-16 and characters split between two XML content strings are left to be decoded one at a time */
+    if (context->encoding > HOXML_ENC_UTF_8 || context->stream_length != 0)
+        return;
+
+    size_t length = (size_t)(context->xml_length - (context->iterator - context->xml));
+    uint8_t is_view = hoxml_is_viewable(context) &&
+        (context->view_length == 0 || context->view + context->view_length == context->iterator);
+    if (!is_view && context->view_length > 0) /* If a view must be copied first, let hoxml_append_view() do it */
+        return;
+    if (!is_view) {
+        /* As in hoxml_append_character(), the last byte of the buffer is never used */
+        size_t available = (size_t)(context->buffer + context->buffer_length - HOXML_STACK->end) - 1;
+        if (length > available)
+            length = available;
+    }
+    if (context->state == HOXML_STATE_OPEN_TAG && context->content_chunk_length > 0) {
+        size_t used = (size_t)(HOXML_STACK->end - &(HOXML_STACK->tag)) + context->view_length;
+        size_t chunk_remaining = used + 1 < context->content_chunk_length ?
+            context->content_chunk_length - used - 1 : 0;
+        if (length > chunk_remaining)
+            length = chunk_remaining;
+    }
+
+    size_t run = hoxml_scan_run(context->iterator, length);
+    if (run == 0)
+        return;
+    if (is_view) {
+        if (context->view_length == 0)
+            context->view = context->iterator;
+        context->view_length += run;
+    } else {
+        HOXML_STACK->flags &= ~HOXML_FLAG_TERMINATED;
+        HOXML_STACK->flags |= HOXML_FLAG_COPIED;
+        memcpy(HOXML_STACK->end + 1, context->iterator, run);
+        HOXML_STACK->end += run;
+    }
+    context->iterator += run;
+    context->column += (uint32_t)run; /* Every character in the run is a single byte and none are line breaks */
+}
+
+/* Return the number of plain characters at the beginning of the given string. Anything else, be it markup ('<' or */
+/* '&'), a quote that might end an attribute value, a line break that must be counted, a multi-byte character, or */
+/* a null terminator, ends the run. */
+size_t hoxml_scan_run(const char* str, size_t length) {
+    size_t i = 0;
+#if defined(HOXML_AVX2)
+    const __m256i less_than = _mm256_set1_epi8('<'), ampersand = _mm256_set1_epi8('&');
+    const __m256i double_quote = _mm256_set1_epi8('"'), single_quote = _mm256_set1_epi8('\'');
+    const __m256i line_feed = _mm256_set1_epi8(0x0A), carriage_return = _mm256_set1_epi8(0x0D);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(str + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, less_than), _mm256_cmpeq_epi8(bytes, ampersand));
+        special = _mm256_or_si256(special, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, double_quote),
+            _mm256_cmpeq_epi8(bytes, single_quote)));
+        special = _mm256_or_si256(special, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, line_feed),
+            _mm256_cmpeq_epi8(bytes, carriage_return)));
+        special = _mm256_or_si256(special, _mm256_cmpeq_epi8(bytes, zero));
+        /* Matches are all ones, so their high bits are set, as are those of bytes at or above 0x80 */
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(special, bytes));
+        if (mask != 0) /* If the run ends within this block, the lowest set bit is where */
+            return i + hoxml_lowest_bit(mask);
+    }
+#elif defined(HOXML_SSE2)
+    const __m128i less_than = _mm_set1_epi8('<'), ampersand = _mm_set1_epi8('&');
+    const __m128i double_quote = _mm_set1_epi8('"'), single_quote = _mm_set1_epi8('\'');
+    const __m128i line_feed = _mm_set1_epi8(0x0A), carriage_return = _mm_set1_epi8(0x0D);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(str + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(bytes, less_than), _mm_cmpeq_epi8(bytes, ampersand));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi8(bytes, double_quote),
+            _mm_cmpeq_epi8(bytes, single_quote)));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi8(bytes, line_feed),
+            _mm_cmpeq_epi8(bytes, carriage_return)));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(bytes, zero));
+        /* Matches are all ones, so their high bits are set, as are those of bytes at or above 0x80 */
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(special, bytes));
+        if (mask != 0) /* If the run ends within this block, the lowest set bit is where */
+            return i + hoxml_lowest_bit(mask);
+    }
+#endif
+    while (i < length && HOXML_IS_PLAIN_CHAR_DATA((unsigned char)str[i]))
+        i++;
+    return i;
+}
+
+#if defined(HOXML_AVX2) || defined(HOXML_SSE2)
+/* Return the index of the lowest set bit in the given mask, which must not be zero */
+uint32_t hoxml_lowest_bit(uint32_t mask) {
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (uint32_t)index;
+    #else
+        return (uint32_t)__builtin_ctz(mask);
+    #endif
+}
+#endif
+
+/* Add the given character, which begins at 'start' in the XML content string or was split between two strings if */
+/* 'start' is NULL, to the attribute value or element content being parsed. This only extends the view of it while */
+/* that's allowed. Otherwise, the view is copied to the stack, if there is one, and so is the character. */
+void hoxml_append_view(hoxml_context_t* context, hoxml_character_t c, const char* start) {
+    if (start != NULL && hoxml_is_viewable(context) &&
+            (context->view_length == 0 || context->view + context->view_length == start)) {
+        if (context->view_length == 0)
+            context->view = start;
+        context->view_length += c.bytes;
+        return;
+    }
+
+    hoxml_copy_view(context);
+    if (context->state >= HOXML_STATE_NONE) /* If copying the viewed characters was successful */
+        hoxml_append_character(context, c);
+    if (context->state >= HOXML_STATE_NONE) /* If appending the character was successful */
+        HOXML_STACK->flags |= HOXML_FLAG_COPIED;
+}
+
+/* Copy the viewed characters, if any, to the end of the stack's current head node. Either all of them are copied or */
+/* none are, in which case the state is changed to the "insufficient memory" error state. */
+void hoxml_copy_view(hoxml_context_t* context) {
+    if (context->view_length == 0)
+        return;
+
+    /* Views of content are kept through the element's end tag. If the XML content string ended in the middle of */
+    /* it, something only a null character can cause, the end tag is on the stack and the content has nowhere to go. */
+    if (context->state != HOXML_STATE_OPEN_TAG && context->state != HOXML_STATE_ATTRIBUTE_VALUE) {
+        context->view = NULL;
+        context->view_length = 0;
+        return;
+    }
+
+    /* As in hoxml_append_character(), the last byte of the buffer is never used */
+    if (HOXML_STACK->end + context->view_length >= context->buffer + context->buffer_length) {
+        context->error_return_state = context->state;
+        context->state = HOXML_STATE_ERROR_INSUFFICIENT_MEMORY;
+        return;
+    }
+
+    HOXML_STACK->flags &= ~HOXML_FLAG_TERMINATED;
+    HOXML_STACK->flags |= HOXML_FLAG_COPIED;
+    memcpy(HOXML_STACK->end + 1, context->view, context->view_length);
+    HOXML_STACK->end += context->view_length;
+    context->view = NULL;
+    context->view_length = 0;
+}
+
+/* Determine whether the attribute value or element content being parsed may be a view: views of it are enabled and */
+/* none of it has been copied to the stack */
+uint8_t hoxml_is_viewable(hoxml_context_t* context) {
+    if (HOXML_STACK->flags & HOXML_FLAG_COPIED)
+        return 0;
+    if (context->state == HOXML_STATE_ATTRIBUTE_VALUE)
+        return (context->views & HOXML_VIEW_VALUE) != 0;
+    if (context->state == HOXML_STATE_OPEN_TAG)
+        return (context->views & HOXML_VIEW_CONTENT) != 0;
+    return 0;
+}
+
 /* Attempt to add a null terminator to the end of the stack's current head node */
 void hoxml_append_terminator(hoxml_context_t* context) {
     if (HOXML_STACK->flags & HOXML_FLAG_TERMINATED) /* If the node's current string is already terminated */
@@ -1132,10 +1415,19 @@ hoxml_code_t hoxml_end_tag(hoxml_context_t* context) {
         } else { /* If an element successfully closed a matching open tag */
             hoxml_pop_stack(context); /* Pop the end tag (e.g. "</tag>") */
             context->tag = &parent->tag;
+            if (context->view_length > 0) { /* If the content was only viewed, hand over the view */
+                context->content_view = context->view;
+                context->content_length = context->view_length;
+                context->view = NULL;
+                context->view_length = 0;
+                return HOXML_ELEMENT_END;
+            }
             /* Element content is placed, in memory, after the tag and its terminator... */
             context->content = context->tag + hoxml_strlen(context->tag, context->encoding);
             /* ...which may be either one or two bytes, depending on encoding */
             context->content += (context->encoding >= HOXML_ENC_UTF_16_BE ? 2 : 1);
+            context->content_view = context->content;
+            context->content_length = (size_t)(parent->end + 1 - context->content);
             return HOXML_ELEMENT_END;
         }
     } else if (node->flags & HOXML_FLAG_EMPTY_ELEMENT) /* Self-closing/empty element (e.g. "<tag/>") */
@@ -1144,9 +1436,40 @@ hoxml_code_t hoxml_end_tag(hoxml_context_t* context) {
         return HOXML_PROCESSING_INSTRUCTION_END;
     /* The only remaining case is an open tag (e.g. "<tag>") and we expect a matching close tag later */
     context->post_state = HOXML_STATE_NONE; /* For this fourth case, of four possible, there is no clean up */
+    node->flags &= ~HOXML_FLAG_COPIED; /* The element's content begins now and none of it has been copied */
     return HOXML_ELEMENT_BEGIN;
 }
 
+/* Determine whether the '<' just parsed begins an end tag that's entirely within the XML content string, meaning */
+/* viewed content can be handed over without having been copied. Only checked for UTF-8 while there is a view. */
+uint8_t hoxml_is_end_tag_ahead(hoxml_context_t* context) {
+    size_t bytes_remaining = (size_t)(context->xml_length - (context->iterator - context->xml));
+    if (context->view_length == 0 || context->encoding > HOXML_ENC_UTF_8 || bytes_remaining < 2)
+        return 0;
+    return *context->iterator == '/' && memchr(context->iterator, '>', bytes_remaining) != NULL;
+}
+
+/* Hand over the content of the open element built up so far, copied or viewed, as a content chunk */
+hoxml_code_t hoxml_content_chunk(hoxml_context_t* context) {
+    context->tag = &(HOXML_STACK->tag);
+    if (context->view_length > 0) { /* If the content was only viewed, hand over the view */
+        context->content = NULL;
+        context->content_view = context->view;
+        context->content_length = context->view_length;
+        context->view = NULL;
+        context->view_length = 0;
+    } else {
+        /* As with a closed element, the content follows the tag and its terminator. Everything past the end of */
+        /* the stack is zeroed so the content is already null terminated. */
+        context->content = context->tag + hoxml_strlen(context->tag, context->encoding);
+        context->content += (context->encoding >= HOXML_ENC_UTF_16_BE ? 2 : 1);
+        context->content_view = context->content;
+        context->content_length = (size_t)(HOXML_STACK->end + 1 - context->content);
+    }
+    context->post_state = HOXML_POST_STATE_CONTENT_CHUNK; /* Drop the content next call */
+    return HOXML_CONTENT_CHUNK;
+}
+
 uint8_t hoxml_post_state_cleanup(hoxml_context_t* context) {
     if (context->post_state != HOXML_STATE_NONE) {
         switch (context->post_state) {
@@ -1169,6 +1492,18 @@ uint8_t hoxml_post_state_cleanup(hoxml_context_t* context) {
             HOXML_STACK->end = context->attribute - 1;
             /* With these public properties now pointing to zeroes, nullify them so there's no confusion */
             context->attribute = context->value = NULL;
+            context->value_view = NULL;
+            context->value_length = 0;
+            break;
+        case HOXML_POST_STATE_CONTENT_CHUNK: /* Remove the content that was handed over from the buffer */
+            if (context->content != NULL) { /* If the content was copied rather than viewed */
+                memset(context->content, 0, HOXML_STACK->end - context->content + 1);
+                HOXML_STACK->end = context->content - 1;
+            }
+            HOXML_STACK->flags &= ~HOXML_FLAG_COPIED; /* The content begins anew */
+            context->tag = context->content = NULL;
+            context->content_view = NULL;
+            context->content_length = 0;
             break;
         }
         context->post_state = HOXML_STATE_NONE;
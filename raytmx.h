@@ -25,6 +25,30 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
     #define RAYTMX_DEC extern
   to specify raytmx function declarations as static or extern, respectively.
   The default specifier is extern.
+
+  CSV tile data is scanned with SSE2 or, when the compiler targets it (e.g. -mavx2), AVX2 on x86. Base64 tile data
+  is decoded with AVX2 or SSE4.1 when the compiler targets either (e.g. -mavx2, -msse4.1, or -march=native). Define
+    #define RAYTMX_NO_SIMD
+  before the implementation to always use the portable scalar parser and decoder. This also applies HOXML_NO_SIMD.
+
+  Tile layers compressed with "gzip" or "zlib" are decompressed by raylib. Layers compressed with "zstd" need
+  libzstd: define
+    #define RAYTMX_SUPPORT_ZSTD
+  before the implementation and link with -lzstd. Otherwise they are reported as unsupported and left empty.
+
+  LoadTMXCached() keeps a compiled copy of each map next to its TMX document (e.g. "level.tmxb"), which is
+  memory-mapped on Unix-likes and read into memory elsewhere. These files are specific to the build that wrote them
+  and are safe to delete at any time. LoadTMXDeferred() does the same without touching the GPU, so it can run on a
+  loading thread, and UploadTexturesTMX() then creates the map's textures on the main thread a few per call.
+
+  The static tiles of tile layers are pre-rendered into textures of 16x16 tiles once a map's textures are loaded, so
+  drawing a layer draws a few of those rather than every tile on screen. Animated tiles are still drawn one by one.
+  Call SetTileLayerBakingTMX(false) before loading a map whose layers' tiles will be changed after it's loaded.
+
+  External tilesets, object templates, and images referenced by a map are loaded in parallel on up to 4 threads
+  (POSIX threads, so link with -lpthread where that's separate). Define
+    #define RAYTMX_MAX_THREADS 1
+  before the implementation to load them one after another instead, or another number to change the limit.
 */
 
 #ifndef RAYTMX_H
@@ -207,6 +231,8 @@ typedef struct tmx_tile_layer {
     char* compression; /**< (Optional) compression used to compress tiles. May be NULL, "gzip," "zlib," or "zstd." */
     uint32_t* tiles; /**< Array of tile Global IDs (GIDs) contained by this tile layer. */
     uint32_t tilesLength; /**< Length of the 'tiles' array. */
+    void* chunks; /**< (Internal) pre-rendered chunks of this layer's static tiles that are drawn in place of them, or
+                       NULL if the layer isn't drawn that way. See SetTileLayerBakingTMX(). */
 } TmxTileLayer;
 
 /**
@@ -438,8 +464,24 @@ typedef struct tmx_map {
     TmxTile* gidsToTiles; /**< Array of pre-calculated tile metadata with all the values needed to quickly draw a tile
                                given its GID. Allocated such that gidsToTiles[1] returns the data of tile GID 1. */
     uint32_t gidsToTilesLength; /**< Length of the 'gidsToTiles' array. */
+    void* cache; /**< (Internal) compiled .tmxb file this map lives in when loaded from one by LoadTMXCached(), or
+                      NULL if the map was parsed from its TMX document. */
 } TmxMap;
 
+/**
+ * Counts of how the buffers TMX, TSX, and TX documents are parsed with have been used. Each document borrows a buffer
+ * from a pool shared by all the loading functions, and threads, and returns it once parsed.
+ */
+typedef struct tmx_parse_stats {
+    uint32_t documentsParsed; /**< Documents parsed, successfully or not. */
+    uint32_t buffersAllocated; /**< Buffers allocated because the pool had none to lend. */
+    uint32_t buffersReused; /**< Documents parsed with a buffer borrowed from the pool. */
+    uint32_t buffersGrown; /**< Times a document outgrew the XML parser's memory and it had to be doubled. */
+    uint32_t buffersPooled; /**< Buffers currently waiting in the pool. */
+    size_t parserMemorySize; /**< Bytes of XML parser memory buffers are given: the most any document has needed. */
+    size_t pooledBytes; /**< Bytes held by the buffers currently waiting in the pool. */
+} TmxParseStats;
+
 /**
  * Given a path to TMX document, parse it and create an equivalent model that can be, among other uses, quickly drawn.
  * This function allocates memory and loads textures into VRAM. To clean up, use UnloadTMX().
@@ -500,6 +542,14 @@ RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const T
  */
 RAYTMX_DEC void AnimateTMX(TmxMap* map);
 
+/**
+ * Rewind the animations of the given map to their first frames, as they are when the map is loaded. With this, a map
+ * can be kept loaded and reused from the start rather than being unloaded and loaded again.
+ *
+ * @param map A loaded map model whose animations are to be reset.
+ */
+RAYTMX_DEC void ResetAnimationsTMX(TmxMap* map);
+
 /**
  * Check for collisions between two objects of arbitrary type. Objects that are not primitive shapes, namely text and
  * tiles, are treated as rectangles.
@@ -674,6 +724,110 @@ RAYTMX_DEC void TraceLogTMX(int logLevel, const TmxMap* map);
  */
 RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags);
 
+/**
+ * Globally enable or disable the loading of textures for images referenced by maps, tilesets, and image layers. With
+ * loading disabled, maps are parsed in full but their textures are left zeroed so no graphics context is needed (e.g.
+ * for headless simulation). Maps loaded this way must not be drawn. Loading is enabled by default.
+ *
+ * @param loadTextures True to load textures, false to skip them.
+ */
+RAYTMX_DEC void SetTextureLoadingTMX(bool loadTextures);
+
+/**
+ * Globally enable or disable the baking of tile layers. With baking enabled, once a map's textures are loaded the
+ * static tiles of each of its tile layers are pre-rendered into render textures, or chunks, of 16x16 tiles and drawing
+ * the layer only draws the chunks on screen. Animated tiles are left out of the chunks and drawn on their own. Layers
+ * with tiles that don't fit their cell exactly (e.g. larger tiles or tile offsets) are drawn tile by tile either way.
+ * Chunks don't see changes made to a layer's tiles after loading so disable baking for maps that will be modified.
+ * Baking is enabled by default.
+ *
+ * @param bakeTileLayers True to bake the tile layers of maps loaded following this call, false to draw them tile by
+ *                       tile. Maps loaded with baking disabled can still be baked later on by BakeTMX().
+ */
+RAYTMX_DEC void SetTileLayerBakingTMX(bool bakeTileLayers);
+
+/**
+ * Bake the tile layers of a loaded map as SetTileLayerBakingTMX() describes, regardless of whether baking is enabled.
+ * This is for maps loaded with baking disabled whose tiles were changed to draw from other textures or source rects
+ * after loading (e.g. to use a texture atlas) and must be baked with those. Layers already baked are left as they are.
+ * This must be called from the thread that created the window. Maps loaded without textures, or with textures still
+ * pending upload (see UploadTexturesTMX()), are not baked.
+ *
+ * @param map A loaded map whose tile layers will be baked.
+ */
+RAYTMX_DEC void BakeTMX(TmxMap* map);
+
+/**
+ * Globally enable or disable the SIMD (SSE/AVX) decoders of CSV and Base64 tile layer data. They're used wherever the
+ * build and CPU support them and give the same results as the portable scalar decoders, so this is only meant for
+ * testing and benchmarking the two against each other. SIMD decoding is enabled by default.
+ *
+ * @param useSIMD True to decode tile layer data with SIMD where supported, false to always use the scalar decoders.
+ */
+RAYTMX_DEC void SetSIMDDecodingTMX(bool useSIMD);
+
+/**
+ * Load a map as LoadTMX() does but through a compiled, binary copy of it cached next to the TMX document with a
+ * ".tmxb" extension (e.g. "level.tmx" is cached as "level.tmxb"). If the cache exists and neither the TMX document nor
+ * the external tilesets and templates it references have changed (by modification time and size) since the cache was
+ * written, it is memory-mapped and fixed up in place so no XML is parsed. Otherwise, the map is loaded by LoadTMX() and
+ * the cache is (re)written. Textures are loaded either way. To clean up, use UnloadTMX().
+ *
+ * @param fileName File name and/or path referencing a TMX document on disk to be loaded.
+ * @return A model of the map as defined by the given TMX document, or NULL if loading failed for any reason.
+ */
+RAYTMX_DEC TmxMap* LoadTMXCached(const char* fileName);
+
+/**
+ * Compile a loaded map into the binary format read by LoadTMXCached() and write it to disk. The format is a single
+ * block of the map's models with offsets in place of pointers. It is only readable by builds of raytmx with the same
+ * models and pointer size.
+ *
+ * @param map A map model loaded from the given TMX document.
+ * @param tmxFileName File name and/or path of the TMX document the map was loaded from. Image paths and the files the
+ *                    map depends on are recorded relative to its directory.
+ * @param fileName File name and/or path of the compiled map to write.
+ * @return True if the compiled map was written, or false if writing it failed.
+ */
+RAYTMX_DEC bool ExportTMXB(const TmxMap* map, const char* tmxFileName, const char* fileName);
+
+/**
+ * Load a map as LoadTMXCached() does but, rather than loading textures, only decode the images into CPU memory and
+ * leave the textures to be uploaded by UploadTexturesTMX(). Nothing here touches the GPU so, unlike the other loading
+ * functions, this may be called from a thread other than the one that created the window, e.g. to load the next map in
+ * the background. The map must not be drawn until UploadTexturesTMX() reports no textures remaining. To clean up, use
+ * UnloadTMX(), even if the textures were never uploaded.
+ *
+ * @param fileName File name and/or path referencing a TMX document on disk to be loaded.
+ * @return A model of the map with its textures pending, or NULL if loading failed for any reason.
+ */
+RAYTMX_DEC TmxMap* LoadTMXDeferred(const char* fileName);
+
+/**
+ * Upload the decoded images of a map loaded by LoadTMXDeferred() as textures, a few at a time so the work can be
+ * spread across frames. This must be called from the thread that created the window. The textures are assigned to the
+ * map's tilesets, tiles, and image layers when the last one is uploaded.
+ *
+ * @param map A map model loaded by LoadTMXDeferred().
+ * @param budget Maximum number of textures to upload with this call.
+ * @return Number of textures left to upload. Zero once the map is ready to be drawn, including when nothing was left.
+ */
+RAYTMX_DEC uint32_t UploadTexturesTMX(TmxMap* map, uint32_t budget);
+
+/**
+ * Get counts of how the buffers documents are parsed with have been allocated and reused. Without POSIX threads (see
+ * RAYTMX_MAX_THREADS), each thread has a pool of its own and these counts are for the calling thread's.
+ *
+ * @return Counts for every document parsed so far.
+ */
+RAYTMX_DEC TmxParseStats GetParseStatsTMX(void);
+
+/**
+ * Free the buffers waiting in the pool documents are parsed with. The pool fills again as documents are loaded so this
+ * is only needed to give the memory back, e.g. once a game is done loading maps.
+ */
+RAYTMX_DEC void UnloadParseBuffersTMX(void);
+
 #ifdef __cplusplus
     }
 #endif /* __cplusplus */
@@ -683,12 +837,106 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags);
 #ifndef HOXML_IMPLEMENTATION
     #define HOXML_IMPLEMENTATION
 #endif
+#if defined(RAYTMX_NO_SIMD) && !defined(HOXML_NO_SIMD)
+    #define HOXML_NO_SIMD
+#endif
 #include "hoxml.h"
 
+#ifdef RAYTMX_SUPPORT_ZSTD
+    #include <zstd.h> /* ZSTD_createDCtx(), ZSTD_decompressStream() */
+#endif
+
+#include <stdio.h> /* fopen(), fread(), fwrite(), rename(), snprintf() */
+#include <time.h> /* time() */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+    #include <fcntl.h> /* open() */
+    #include <sys/mman.h> /* mmap(), munmap() */
+    #include <sys/stat.h> /* fstat() */
+    #include <unistd.h> /* close(), getpid(), write() */
+    #include <errno.h> /* errno, EEXIST, EINTR */
+    #define RAYTMX_TMXB_MMAP /* Compiled maps are memory-mapped rather than read into memory */
+#endif
+
+#if !defined(RAYTMX_NO_SIMD) && defined(__AVX2__)
+    #include <immintrin.h> /* AVX2 intrinsics */
+    #define RAYTMX_CSV_AVX2
+#elif !defined(RAYTMX_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h> /* SSE2 intrinsics */
+    #define RAYTMX_CSV_SSE2
+#endif
+#if defined(RAYTMX_CSV_AVX2) || defined(RAYTMX_CSV_SSE2)
+    #define RAYTMX_CSV_SIMD
+    #ifdef _MSC_VER
+        #include <intrin.h> /* _BitScanForward64() */
+    #endif
+#endif
+/* The Base64 decoder's SIMD kernels need SSE4.1 or AVX2. Builds targeting either use it directly. Otherwise, GCC and */
+/* Clang on x86 compile both kernels for their instruction sets and pick one at run time from what the CPU supports, */
+/* so default builds (plain x86-64, i.e. SSE2) get them too. */
+#define RAYTMX_BASE64_AVX2_BLOCK 32 /* Characters decoded per AVX2 iteration, and bytes stored (only 24 are kept) */
+#define RAYTMX_BASE64_SSE41_BLOCK 16 /* Characters decoded per SSE4.1 iteration, and bytes stored (only 12 are kept) */
+#if !defined(RAYTMX_NO_SIMD) && defined(__AVX2__)
+    #include <immintrin.h> /* AVX2 intrinsics */
+    #define RAYTMX_BASE64_AVX2
+    #define RAYTMX_TARGET_AVX2
+#elif !defined(RAYTMX_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+        (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+    #include <immintrin.h> /* SSSE3, SSE4.1, and AVX2 intrinsics, usable in functions targeting them */
+    #define RAYTMX_BASE64_AVX2
+    #define RAYTMX_BASE64_SSE41
+    #define RAYTMX_BASE64_DISPATCH
+    #define RAYTMX_TARGET_AVX2 __attribute__((target("avx2")))
+    #define RAYTMX_TARGET_SSE41 __attribute__((target("sse4.1")))
+#elif !defined(RAYTMX_NO_SIMD) && (defined(__SSE4_1__) || (defined(_MSC_VER) && defined(__AVX__)))
+    #include <smmintrin.h> /* SSSE3 and SSE4.1 intrinsics */
+    #define RAYTMX_BASE64_SSE41
+    #define RAYTMX_TARGET_SSE41
+#endif
+#if defined(RAYTMX_BASE64_AVX2) || defined(RAYTMX_BASE64_SSE41)
+    #define RAYTMX_BASE64_SIMD
+#endif
+
+/* Storage for the few statics that loading writes to, so LoadTMXDeferred() can run on multiple threads at once */
+#if defined(__cplusplus) && __cplusplus >= 201103L
+    #define RAYTMX_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+    #define RAYTMX_THREAD_LOCAL _Thread_local
+#elif defined(_MSC_VER)
+    #define RAYTMX_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+    #define RAYTMX_THREAD_LOCAL __thread
+#else
+    #define RAYTMX_THREAD_LOCAL
+#endif
+
+/* External tilesets, templates, and images are loaded on up to this many threads, counting the caller's. Defining */
+/* it as 1, or building for a platform without POSIX threads, loads them one after another on the caller's thread. */
+#ifndef RAYTMX_MAX_THREADS
+    #define RAYTMX_MAX_THREADS 4
+#endif
+#if RAYTMX_MAX_THREADS > 1 && (defined(__unix__) || defined(__APPLE__) || defined(__MINGW32__)) && \
+        !defined(__EMSCRIPTEN__)
+    #include <pthread.h> /* pthread_create(), pthread_join(), pthread_mutex_lock() */
+    #define RAYTMX_THREADS
+#endif
+
 /******************/
 /* Implementation */
 
 #define TMX_LINE_THICKNESS 3.0f /* Thickness, in pixels, that outlines of specific objects are drawn with */
+#define RAYTMX_ARENA_BLOCK_SIZE (64 * 1024) /* Size, in bytes, of the first arena block. Each new block doubles it. */
+#define RAYTMX_ARENA_MAX_BLOCK_SIZE (16 * 1024 * 1024) /* Blocks stop doubling in size once they reach this */
+#define RAYTMX_ARENA_ALIGNMENT 16 /* Alignment of every arena allocation, enough for any node's members */
+#define RAYTMX_CSV_CHUNK 64 /* Bytes of CSV classified per SIMD iteration, one bit each in a 64-bit mask */
+#define RAYTMX_BAKE_CHUNK 16 /* Width and height, in tiles, of the chunks tile layers are pre-rendered in */
+#define RAYTMX_STREAM_CHUNK (64 * 1024) /* Bytes of a document read, and of <data> content decoded, at a time */
+#define RAYTMX_PARSE_BUFFER_SIZE 4096 /* Least size of hoxml's buffer, which doubles whenever it runs out */
+#define RAYTMX_BASE64_INVALID 0xFF /* Base64 decoding table entry for characters that can't appear in the data */
+#define RAYTMX_BASE64_SPACE 0xFE /* Base64 decoding table entry for whitespace, which is skipped */
+#define RAYTMX_BASE64_PADDING 0xFD /* Base64 decoding table entry for '=', which ends the data */
+#define RAYTMX_TMXB_VERSION 3 /* Bumped whenever the layout of compiled maps (.tmxb files) changes */
+#define RAYTMX_TMXB_ALIGNMENT 8 /* Alignment of every block within a compiled map, enough for any model's members */
 
 /* Bit flags that GIDs may be masked with in order to indicate transformations for individual tiles */
 enum tmx_flip_flags {
@@ -708,16 +956,41 @@ typedef struct raytmx_tileset_node RaytmxTilesetNode;
 typedef struct raytmx_tileset_tile_node RaytmxTilesetTileNode;
 typedef struct raytmx_animation_frame_node RaytmxAnimationFrameNode;
 typedef struct raytmx_layer_node RaytmxLayerNode;
-typedef struct raytmx_tile_layer_tile_node RaytmxTileLayerTileNode;
 typedef struct raytmx_object_node RaytmxObjectNode;
 typedef struct raytmx_object_sorting_node RaytmxObjectSortingNode;
 typedef struct raytmx_poly_point_node RaytmxPolyPointNode;
 typedef struct raytmx_text_line_node RaytmxTextLineNode;
+typedef struct raytmx_arena_block RaytmxArenaBlock;
+typedef struct raytmx_tmxb_header RaytmxTmxbHeader;
+typedef struct raytmx_tmxb_relocation RaytmxTmxbRelocation;
+typedef struct raytmx_tmxb_texture RaytmxTmxbTexture;
+typedef struct raytmx_tmxb_dependency RaytmxTmxbDependency;
+typedef struct raytmx_tmxb_block RaytmxTmxbBlock;
+typedef struct raytmx_tmxb_writer RaytmxTmxbWriter;
+typedef struct raytmx_prefetch_entry RaytmxPrefetchEntry;
+typedef struct raytmx_prefetch RaytmxPrefetch;
+typedef struct raytmx_task_queue RaytmxTaskQueue;
+typedef struct raytmx_parse_buffer RaytmxParseBuffer;
+typedef struct raytmx_tile_chunk RaytmxTileChunk;
+typedef struct raytmx_tile_chunks RaytmxTileChunks;
 typedef enum raytmx_document_format {
     FORMAT_TMX = 0, /* Tilemap with tilesets, layers, etc. */
     FORMAT_TSX, /* External tilesets */
     FORMAT_TX /* Object templates */
 } RaytmxDocumentFormat;
+typedef enum raytmx_token { /* Element and attribute names raytmx looks for, see GetToken() */
+    TOKEN_UNKNOWN = 0, TOKEN_ANIMATION, TOKEN_BACKGROUNDCOLOR, TOKEN_BOLD, TOKEN_CLASS, TOKEN_COLOR, TOKEN_COLUMNS,
+    TOKEN_COMPRESSION, TOKEN_DATA, TOKEN_DRAWORDER, TOKEN_DURATION, TOKEN_ELLIPSE, TOKEN_ENCODING, TOKEN_FIRSTGID,
+    TOKEN_FONTFAMILY, TOKEN_FRAME, TOKEN_GID, TOKEN_GROUP, TOKEN_HALIGN, TOKEN_HEIGHT, TOKEN_ID, TOKEN_IMAGE,
+    TOKEN_IMAGELAYER, TOKEN_ITALIC, TOKEN_KERNING, TOKEN_LAYER, TOKEN_MAP, TOKEN_MARGIN, TOKEN_NAME, TOKEN_OBJECT,
+    TOKEN_OBJECTALIGNMENT, TOKEN_OBJECTGROUP, TOKEN_OFFSETX, TOKEN_OFFSETY, TOKEN_OPACITY, TOKEN_ORIENTATION,
+    TOKEN_PARALLAXORIGINX, TOKEN_PARALLAXORIGINY, TOKEN_PARALLAXX, TOKEN_PARALLAXY, TOKEN_PIXELSIZE, TOKEN_POINT,
+    TOKEN_POINTS, TOKEN_POLYGON, TOKEN_POLYLINE, TOKEN_PROPERTIES, TOKEN_PROPERTY, TOKEN_RENDERORDER, TOKEN_REPEATX,
+    TOKEN_REPEATY, TOKEN_ROTATION, TOKEN_SOURCE, TOKEN_SPACING, TOKEN_STRIKEOUT, TOKEN_TEMPLATE, TOKEN_TEXT, TOKEN_TILE,
+    TOKEN_TILECOUNT, TOKEN_TILEHEIGHT, TOKEN_TILEID, TOKEN_TILEOFFSET, TOKEN_TILESET, TOKEN_TILEWIDTH, TOKEN_TINTCOLOR,
+    TOKEN_TRANS, TOKEN_TYPE, TOKEN_UNDERLINE, TOKEN_VALIGN, TOKEN_VALUE, TOKEN_VISIBLE, TOKEN_WIDTH, TOKEN_WRAP,
+    TOKEN_X, TOKEN_Y
+} RaytmxToken;
 typedef struct raytmx_external_tileset {
     TmxTileset tileset;
     bool isSuccess; /* 'isSuccess' is true when the external tileset was successfully loaded */
@@ -758,10 +1031,6 @@ typedef struct raytmx_layer_node {
     uint32_t childrenLength;
     RaytmxLayerNode *next, *parent, *childrenRoot, *childrenTail;
 } RaytmxLayerNode;
-typedef struct raytmx_tile_layer_tile_node {
-    uint32_t gid;
-    RaytmxTileLayerTileNode* next;
-} RaytmxTileLayerTileNode;
 typedef struct raytmx_object_node {
     TmxObject object;
     RaytmxObjectNode* next;
@@ -779,6 +1048,99 @@ typedef struct raytmx_text_line_node {
     TmxTextLine line;
     RaytmxTextLineNode* next;
 } RaytmxTextLineNode;
+typedef struct raytmx_arena_block {
+    RaytmxArenaBlock* next; /* The previous, full block or NULL */
+    size_t used, capacity; /* In bytes, not counting this header */
+} RaytmxArenaBlock; /* Header of a chunk of arena memory. The chunk's 'capacity' bytes follow the (aligned) header. */
+typedef struct raytmx_tmxb_header {
+    char magic[4]; /* "TMXB" */
+    uint32_t version; /* RAYTMX_TMXB_VERSION */
+    uint32_t layout[10]; /* Sizes of a pointer and the models, so files from incompatible builds are rejected */
+    uint32_t length; /* Length of the whole file */
+    uint32_t mapOffset; /* The TmxMap, followed by everything it points to */
+    uint32_t relocationsOffset, relocationsLength;
+    uint32_t texturesOffset, texturesLength;
+    uint32_t dependenciesOffset, dependenciesLength;
+    uint32_t isMapped; /* (Runtime) nonzero if the file was memory-mapped rather than read into allocated memory */
+    uint32_t texturesUploaded; /* (Runtime) textures through which the images have been uploaded or loaded */
+} RaytmxTmxbHeader; /* Start of a compiled map (.tmxb file). Every offset is in bytes from the start of the file. */
+typedef enum raytmx_tmxb_relocation_kind {
+    TMXB_RELOCATE_POINTER = 0, /* Pointer stored as an offset, to be made absolute */
+    TMXB_RELOCATE_TEXTURE, /* Texture2D to be set to one of the file's textures */
+    TMXB_RELOCATE_FONT /* Font to be set to raylib's default font */
+} RaytmxTmxbRelocationKind;
+typedef struct raytmx_tmxb_relocation {
+    uint32_t kind; /* RaytmxTmxbRelocationKind */
+    uint32_t offset; /* Where the pointer, texture, or font to fix up is */
+    uint32_t texture; /* Index of the texture for TMXB_RELOCATE_TEXTURE */
+} RaytmxTmxbRelocation; /* Fix-up applied to a compiled map once it's loaded */
+typedef struct raytmx_tmxb_texture {
+    uint32_t path; /* Offset of the image's path, relative to the TMX document's directory */
+    Texture2D texture; /* Loaded along with the compiled map and shared by every image with the same path */
+    Image image; /* (Runtime) image decoded by LoadTMXDeferred() and waiting for UploadTexturesTMX() */
+} RaytmxTmxbTexture;
+typedef struct raytmx_tmxb_dependency {
+    int64_t modTime, fileLength; /* As of when the compiled map was written */
+    uint32_t path; /* Offset of the file's path, relative to the TMX document's directory */
+} RaytmxTmxbDependency; /* Source file that invalidates the compiled map when changed */
+typedef struct raytmx_tmxb_block {
+    const void* source;
+    uint32_t offset;
+} RaytmxTmxbBlock; /* Array already written to a compiled map, found by the address it was copied from */
+typedef struct raytmx_tmxb_writer {
+    unsigned char* data;
+    uint32_t length, capacity;
+    RaytmxTmxbRelocation* relocations;
+    uint32_t relocationsLength, relocationsCapacity;
+    RaytmxTmxbBlock* blocks; /* Open-addressed hash table so arrays shared by multiple models are written once */
+    uint32_t blocksLength, blocksCapacity;
+    char** texturePaths; /* Paths of the textures to be loaded with the compiled map, without duplicates */
+    uint32_t texturePathsLength, texturePathsCapacity;
+    char** dependencyPaths; /* Paths of the files the compiled map was made from, without duplicates */
+    uint32_t dependencyPathsLength, dependencyPathsCapacity;
+    bool isOutOfMemory;
+} RaytmxTmxbWriter; /* Compiled map being built by ExportTMXB() */
+typedef enum raytmx_prefetch_kind {
+    PREFETCH_IMAGE = 0, /* Image decoded for a texture */
+    PREFETCH_TSX, /* External tileset */
+    PREFETCH_TX /* Object template */
+} RaytmxPrefetchKind;
+typedef struct raytmx_prefetch_entry {
+    RaytmxPrefetchKind kind;
+    char* fullPath;
+    bool isClaimed; /* External tilesets and templates are handed over once, images are copied into textures */
+    Image image;
+    RaytmxExternalTileset externalTileset;
+    RaytmxObjectTemplate objectTemplate;
+} RaytmxPrefetchEntry; /* External resource of a TMX document, loaded before the document is parsed */
+typedef struct raytmx_prefetch {
+    RaytmxPrefetchEntry* entries;
+    uint32_t entriesLength, entriesCapacity;
+} RaytmxPrefetch; /* Every external resource a TMX document was found to reference, loaded in parallel */
+typedef void (*RaytmxTaskFunction)(void* tasks, uint32_t index);
+typedef struct raytmx_task_queue {
+    RaytmxTaskFunction function;
+    void* tasks;
+    uint32_t length, next; /* Number of tasks and index of the next one to be taken */
+#ifdef RAYTMX_THREADS
+    pthread_mutex_t mutex; /* Guards 'next' */
+#endif
+} RaytmxTaskQueue; /* Tasks shared by the threads of RunTasks() */
+typedef struct raytmx_parse_buffer {
+    char* content; /* RAYTMX_STREAM_CHUNK bytes, allocated along with this struct, the document is read into */
+    char* parserMemory; /* Buffer handed to hoxml, which holds the open elements and the string being parsed */
+    size_t parserMemoryLength; /* Length of 'parserMemory' in bytes */
+    RaytmxParseBuffer* next;
+} RaytmxParseBuffer; /* Memory needed to parse one document, lent out by a pool so it's reused by the next document */
+typedef struct raytmx_tile_chunk {
+    RenderTexture2D renderTexture; /* Static tiles of the chunk, pre-rendered. Zeroed if the chunk has none. */
+    uint32_t animatedTilesOffset, animatedTilesLength; /* Range of the chunk's tiles within 'animatedTiles' */
+} RaytmxTileChunk;
+typedef struct raytmx_tile_chunks {
+    RaytmxTileChunk* chunks; /* Row-major array of RAYTMX_BAKE_CHUNK by RAYTMX_BAKE_CHUNK tile chunks */
+    uint32_t columns, rows; /* Dimensions of the 'chunks' array */
+    uint32_t* animatedTiles; /* Indexes into the layer's tiles of the animated ones, which are drawn every frame */
+} RaytmxTileChunks; /* A tile layer's static tiles rendered ahead of time, see BakeTMXTileLayer() */
 typedef struct raytmx_state {
     RaytmxDocumentFormat format;
     char documentDirectory[512];
@@ -816,18 +1178,41 @@ typedef struct raytmx_state {
     RaytmxTilesetTileNode *tilesetTilesRoot, *tilesetTilesTail;
     RaytmxAnimationFrameNode *animationFramesRoot, *animationFramesTail;
     RaytmxLayerNode *layersRoot, *layersTail, *groupNode;
-    RaytmxTileLayerTileNode *layerTilesRoot, *layerTilesTail;
     RaytmxObjectNode *objectsRoot, *objectsTail;
     uint32_t tilesetsLength, tilesetTilesLength, animationFramesLength, propertiesLength, layersLength,
-        layerTilesLength, objectsLength, propertiesDepth;
+        objectsLength, propertiesDepth;
+
+    /* A <layer>'s 'width' and 'height' are known before its <data> so its tiles array is allocated up front and */
+    /* GIDs are decoded straight into it. 'layerTiles' is that array while its <data> is being parsed, or NULL. */
+    uint32_t* layerTiles;
+    uint32_t layerTilesLength, layerTilesCapacity; /* GIDs decoded so far (even past capacity) and array length */
+    /* <data> content is decoded a chunk at a time as it's parsed so a GID or a group of four Base64 characters may */
+    /* be split between two chunks. The start of it is held back in 'dataCarry' until the next chunk finishes it. */
+    char dataCarry[16];
+    uint32_t dataCarryLength;
+    /* Bytes of Base64 decoded so far, straight into 'layerTiles' or, if they're compressed, into 'dataDecoded' to */
+    /* be decompressed once all of them are there */
+    unsigned char* dataDecoded;
+    size_t dataDecodedLength, dataDecodedCapacity;
+    bool isDataInvalid; /* Set when Base64 decoding stopped at an invalid character */
+
+    /* Bump allocator backing every linked list node above, and other nodes that only live during parsing. Nodes */
+    /* are never freed one by one, the whole arena is released at once by FreeState(). */
+    RaytmxArenaBlock* arena;
 } RaytmxState; /* Intermediate data used internally to parse TMX (map), TSX (tileset), and TX (template) files */
 
 RaytmxExternalTileset LoadTSX(const char* fileName);
 RaytmxObjectTemplate LoadTX(const char* fileName);
 void ParseDocument(RaytmxState* raytmxState, const char* fileName);
+RaytmxParseBuffer* BorrowParseBuffer(void);
+void ReturnParseBuffer(RaytmxParseBuffer* parseBuffer, uint32_t timesGrown);
+void LockParseBuffers(void);
+void UnlockParseBuffers(void);
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
+void HandleContentChunk(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
+RaytmxToken GetToken(const char* name);
 void FreeState(RaytmxState* raytmxState);
 void FreeString(char* str);
 void FreeTileset(TmxTileset tileset);
@@ -837,6 +1222,12 @@ void FreeObject(TmxObject object);
 bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle screenRect, uint32_t* rawGid,
     TmxTile* tile, Rectangle* tileRect);
 void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
+void DrawTMXTileLayerChunks(const TmxMap* map, Rectangle screenRect, const TmxTileLayer* layer, int posX, int posY,
+    Color tint);
+void BakeTMXTileLayers(const TmxMap* map, TmxLayer* layers, uint32_t layersLength);
+RaytmxTileChunks* BakeTMXTileLayer(const TmxMap* map, const TmxTileLayer* layer);
+bool IsTileBakeable(const TmxMap* map, uint32_t gid);
+void UnloadTMXTileLayerChunks(TmxLayer* layers, uint32_t layersLength);
 void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, Color tint);
 void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, float width,
     float height, Color tint);
@@ -853,6 +1244,18 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces);
 void StringCopy(char* destination, const char* source);
 TmxProperty* AddProperty(RaytmxState* raytmxState);
 void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid);
+void AddTileLayerTiles(RaytmxState* raytmxState, const void* gids, uint32_t gidsLength);
+void ParseCSVTiles(RaytmxState* raytmxState, const char* csv, size_t length);
+size_t ParseCSVTilesScalar(RaytmxState* raytmxState, const char* csv, size_t length);
+void ParseDataContent(RaytmxState* raytmxState, const char* content, size_t length, bool isFinal);
+void DecodeDataContent(RaytmxState* raytmxState, const char* content, size_t length);
+bool DecodeBase64(const char* encoded, size_t length, unsigned char* output, size_t outputCapacity,
+    size_t* outputLength);
+#ifdef RAYTMX_SUPPORT_ZSTD
+bool DecompressZstdTiles(RaytmxState* raytmxState, const void* compressed, size_t compressedLength);
+#endif
+bool DecodeBase64Scalar(const char* encoded, size_t length, unsigned char* output, size_t outputCapacity,
+    size_t* outputLength);
 TmxTileset* AddTileset(RaytmxState* raytmxState);
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState);
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState);
@@ -865,10 +1268,71 @@ Color GetColorFromHexString(const char* hex);
 uint32_t GetGid(uint32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVertically, bool* isFlippedDiagonally,
     bool* isRotatedHexagonal120);
 void* MemAllocZero(unsigned int size);
+void* ArenaAllocZero(RaytmxState* raytmxState, size_t size);
+void FreeArena(RaytmxState* raytmxState);
 char* GetDirectoryPath2(const char* filePath);
 char* JoinPath(const char* prefix, const char* suffix);
 void StringCopyN(char* destination, const char* source, size_t number);
 void StringConcatenate(char* destination, const char* source);
+void PrefetchTMX(RaytmxPrefetch* prefetch, const char* fileName);
+void ScanPrefetchReferences(RaytmxPrefetch* prefetch, const char* fileName, int depth);
+bool AddPrefetchEntry(RaytmxPrefetch* prefetch, RaytmxPrefetchKind kind, const char* fullPath);
+void RunPrefetchTask(void* tasks, uint32_t index);
+RaytmxPrefetchEntry* FindPrefetchEntry(RaytmxPrefetch* prefetch, RaytmxPrefetchKind kind, const char* fullPath);
+void LoadTilesetTextures(TmxTileset* tileset, const char* documentDirectory);
+void GetTilesetDirectory(char* tilesetDirectory, const TmxTileset* tileset, const char* documentDirectory);
+void FreePrefetch(RaytmxPrefetch* prefetch);
+void RunTasks(RaytmxTaskFunction function, void* tasks, uint32_t length);
+#ifdef RAYTMX_THREADS
+void* RunTaskQueue(void* taskQueue);
+#endif
+unsigned char* CompileTMXB(const TmxMap* map, const char* tmxFileName, uint32_t* length);
+TmxMap* LoadTMXB(const char* tmxFileName, const char* fileName, bool deferTextures);
+TmxMap* OpenTMXB(unsigned char* data, bool isMapped, const char* mapDirectory, bool deferTextures);
+void RelocateTMXBTextures(unsigned char* data);
+void UnloadTMXB(void* cache);
+bool GetTMXBFileName(char* cacheFileName, size_t size, const char* fileName);
+bool WriteTMXBFile(const unsigned char* data, uint32_t length, const char* fileName);
+unsigned char* MapTMXBFile(const char* fileName, uint32_t* length);
+void UnmapTMXBFile(unsigned char* data, uint32_t length);
+bool IsTMXBValid(const unsigned char* data, uint32_t length, const char* mapDirectory);
+void GetTMXBLayout(uint32_t* layout);
+bool ReserveTMXB(RaytmxTmxbWriter* writer, void** array, uint32_t* capacity, uint32_t needed, size_t elementSize);
+uint32_t AppendTMXB(RaytmxTmxbWriter* writer, const void* source, size_t size);
+uint32_t AppendTMXBBlock(RaytmxTmxbWriter* writer, const void* source, size_t size, bool* isNew);
+uint32_t AddTMXBPath(RaytmxTmxbWriter* writer, char*** paths, uint32_t* pathsLength, uint32_t* pathsCapacity,
+    const char* path);
+void AddTMXBRelocation(RaytmxTmxbWriter* writer, RaytmxTmxbRelocationKind kind, uint32_t offset, uint32_t texture);
+void SetTMXBPointer(RaytmxTmxbWriter* writer, uint32_t slot, uint32_t target);
+void WriteTMXBString(RaytmxTmxbWriter* writer, uint32_t slot, const char* string);
+void WriteTMXBTexture(RaytmxTmxbWriter* writer, uint32_t slot, const char* imageSource, const char* documentPath);
+void WriteTMXBImage(RaytmxTmxbWriter* writer, uint32_t image, const TmxImage* source, const char* documentPath);
+void WriteTMXBProperties(RaytmxTmxbWriter* writer, uint32_t slot, const TmxProperty* properties, uint32_t length);
+void WriteTMXBObjectGroup(RaytmxTmxbWriter* writer, uint32_t group, const TmxObjectGroup* source);
+void WriteTMXBTilesets(RaytmxTmxbWriter* writer, uint32_t slot, const TmxTileset* tilesets, uint32_t length);
+void WriteTMXBLayers(RaytmxTmxbWriter* writer, uint32_t slot, const TmxLayer* layers, uint32_t length);
+void WriteTMXBTiles(RaytmxTmxbWriter* writer, uint32_t slot, const TmxMap* map);
+void FreeTMXBWriter(RaytmxTmxbWriter* writer);
+
+static int tmxLogFlags = 0;
+static bool tmxLoadTextures = true;
+static bool tmxBakeTileLayers = true;
+static bool tmxDecodeSIMD = true;
+static RAYTMX_THREAD_LOCAL bool tmxDeferTextures = false; /* Set by LoadTMXDeferred() while parsing on its thread */
+
+/* Resources loaded ahead of time by PrefetchTMX() for the document LoadTMX() is parsing on this thread, if any */
+static RAYTMX_THREAD_LOCAL RaytmxPrefetch* tmxPrefetch = NULL;
+
+/* Pool of buffers documents are parsed with, see BorrowParseBuffer(), and counts of its use. With POSIX threads the */
+/* pool is shared and guarded by a mutex. Without them there's no lock to share it with so each thread has its own. */
+#ifdef RAYTMX_THREADS
+    #define RAYTMX_PARSE_POOL_LOCAL
+static pthread_mutex_t tmxParseBuffersMutex = PTHREAD_MUTEX_INITIALIZER;
+#else
+    #define RAYTMX_PARSE_POOL_LOCAL RAYTMX_THREAD_LOCAL
+#endif
+static RAYTMX_PARSE_POOL_LOCAL RaytmxParseBuffer* tmxParseBuffers = NULL;
+static RAYTMX_PARSE_POOL_LOCAL TmxParseStats tmxParseStats;
 
 /**********************************************************************************************************************/
 /* Public implementation.                                                                                             */
@@ -881,10 +1345,20 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
     /* Initialize the map object */
     TmxMap* map = (TmxMap*)MemAllocZero(sizeof(TmxMap));
 
+    /* Load the external tilesets, object templates, and images the document references in parallel ahead of */
+    /* parsing it. The parse then takes them as it comes across the references instead of loading them one by one. */
+    RaytmxPrefetch prefetch[1];
+    memset(prefetch, 0, sizeof(RaytmxPrefetch));
+    PrefetchTMX(prefetch, fileName);
+
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
+    tmxPrefetch = prefetch;
     ParseDocument(raytmxState, fileName);
+    tmxPrefetch = NULL;
+    FreePrefetch(prefetch); /* Anything left unclaimed wasn't actually referenced */
     if (!raytmxState->isSuccess) {
+        FreeState(raytmxState); /* Release whatever was parsed before the failure */
         UnloadTMX(map);
         return NULL;
     }
@@ -1030,6 +1504,11 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
     /* Free the linked lists and zeroize related values */
     FreeState(raytmxState);
 
+    /* With its textures loaded, the map's tile layers can be pre-rendered. Deferred loading leaves that to */
+    /* UploadTexturesTMX() since it's done on the GPU. */
+    if (tmxBakeTileLayers && tmxLoadTextures && !tmxDeferTextures)
+        BakeTMXTileLayers(map, map->layers, map->layersLength);
+
     return map;
 }
 
@@ -1037,6 +1516,13 @@ RAYTMX_DEC void UnloadTMX(TmxMap* map) {
     if (map == NULL)
         return;
 
+    UnloadTMXTileLayerChunks(map->layers, map->layersLength);
+
+    if (map->cache != NULL) { /* If the map lives in a compiled map, it's freed all at once along with its textures */
+        UnloadTMXB(map->cache);
+        return;
+    }
+
     if (map->fileName != NULL)
         MemFree(map->fileName);
 
@@ -1155,6 +1641,16 @@ RAYTMX_DEC void AnimateTMX(TmxMap* map) {
     }
 }
 
+RAYTMX_DEC void ResetAnimationsTMX(TmxMap* map) {
+    if (map == NULL)
+        return;
+
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        map->gidsToTiles[gid].frameIndex = 0;
+        map->gidsToTiles[gid].frameTime = 0.0f;
+    }
+}
+
 /**
  * Helper function that creates a TmxObject equivalent to the given rectangle.
  *
@@ -1360,8 +1856,6 @@ RAYTMX_DEC bool CheckCollisionTMXObjectGroupPolyEx(TmxObjectGroup group, Vector2
     return CheckCollisionTMXObjectGroupObject(group, CreatePolygonTMXObject(points, pointCount, aabb), outputObject);
 }
 
-static int tmxLogFlags = 0;
-
 RAYTMX_DEC void TraceLogTMX(int logLevel, const TmxMap* map) {
     if (map == NULL)
         return;
@@ -1401,10 +1895,159 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags) {
     tmxLogFlags = logFlags;
 }
 
+RAYTMX_DEC void SetTextureLoadingTMX(bool loadTextures) {
+    tmxLoadTextures = loadTextures;
+}
+
+RAYTMX_DEC void SetTileLayerBakingTMX(bool bakeTileLayers) {
+    tmxBakeTileLayers = bakeTileLayers;
+}
+
+RAYTMX_DEC void BakeTMX(TmxMap* map) {
+    if (map == NULL || !tmxLoadTextures)
+        return;
+    if (map->cache != NULL) { /* If the map is in compiled form, its textures may not be uploaded yet */
+        RaytmxTmxbHeader* header = (RaytmxTmxbHeader*)map->cache;
+        if (header->texturesUploaded < header->texturesLength)
+            return;
+    }
+    BakeTMXTileLayers(map, map->layers, map->layersLength);
+}
+
+RAYTMX_DEC void SetSIMDDecodingTMX(bool useSIMD) {
+    tmxDecodeSIMD = useSIMD;
+}
+
+RAYTMX_DEC TmxMap* LoadTMXCached(const char* fileName) {
+    if (fileName == NULL)
+        return NULL;
+
+    char cacheFileName[512];
+    if (!GetTMXBFileName(cacheFileName, sizeof(cacheFileName), fileName))
+        return LoadTMX(fileName);
+
+    TmxMap* map = LoadTMXB(fileName, cacheFileName, false);
+    if (map != NULL)
+        return map;
+
+    /* Without a valid cache, parse the TMX document and (re)write the cache for next time */
+    map = LoadTMX(fileName);
+    if (map != NULL && !ExportTMXB(map, fileName, cacheFileName))
+        TraceLog(LOG_WARNING, "RAYTMX: Unable to write compiled map \"%s\"", cacheFileName);
+    return map;
+}
+
+RAYTMX_DEC bool ExportTMXB(const TmxMap* map, const char* tmxFileName, const char* fileName) {
+    if (map == NULL || tmxFileName == NULL || fileName == NULL)
+        return false;
+
+    uint32_t length = 0;
+    unsigned char* data = CompileTMXB(map, tmxFileName, &length);
+    if (data == NULL)
+        return false;
+    bool isSuccess = WriteTMXBFile(data, length, fileName);
+    MemFree(data);
+    return isSuccess;
+}
+
+RAYTMX_DEC TmxMap* LoadTMXDeferred(const char* fileName) {
+    if (fileName == NULL)
+        return NULL;
+
+    char cacheFileName[512];
+    bool isCacheable = GetTMXBFileName(cacheFileName, sizeof(cacheFileName), fileName);
+    TmxMap* map = isCacheable ? LoadTMXB(fileName, cacheFileName, true) : NULL;
+    if (map != NULL)
+        return map;
+
+    /* Without a valid cache, parse the TMX document with textures held back (on this thread only) and compile it in */
+    /* memory. The compiled map is what's returned so its texture table can be uploaded like a cached one's. */
+    tmxDeferTextures = true;
+    TmxMap* parsedMap = LoadTMX(fileName);
+    tmxDeferTextures = false;
+    if (parsedMap == NULL)
+        return NULL;
+
+    uint32_t length = 0;
+    unsigned char* data = CompileTMXB(parsedMap, fileName, &length);
+    UnloadTMX(parsedMap); /* Has no textures to unload, so this is safe off the main thread as well */
+    if (data == NULL)
+        return NULL;
+    if (isCacheable && !WriteTMXBFile(data, length, cacheFileName))
+        TraceLog(LOG_WARNING, "RAYTMX: Unable to write compiled map \"%s\"", cacheFileName);
+
+    char mapDirectory[512];
+    StringCopy(mapDirectory, GetDirectoryPath2(fileName));
+    return OpenTMXB(data, false, mapDirectory, true);
+}
+
+RAYTMX_DEC uint32_t UploadTexturesTMX(TmxMap* map, uint32_t budget) {
+    if (map == NULL || map->cache == NULL) /* Only maps in compiled form can have textures pending */
+        return 0;
+
+    unsigned char* data = (unsigned char*)map->cache;
+    RaytmxTmxbHeader* header = (RaytmxTmxbHeader*)data;
+    if (header->texturesUploaded == header->texturesLength)
+        return 0;
+
+    RaytmxTmxbTexture* textures = (RaytmxTmxbTexture*)(data + header->texturesOffset);
+    for (; budget > 0 && header->texturesUploaded < header->texturesLength; budget--) {
+        RaytmxTmxbTexture* texture = &textures[header->texturesUploaded++];
+        if (texture->image.data == NULL) /* If decoding failed or textures are disabled */
+            continue;
+        texture->texture = LoadTextureFromImage(texture->image);
+        UnloadImage(texture->image);
+        memset(&texture->image, 0, sizeof(Image));
+    }
+
+    /* With the last texture uploaded, hand all of them out at once and pre-render the tile layers with them */
+    if (header->texturesUploaded == header->texturesLength) {
+        RelocateTMXBTextures(data);
+        if (tmxBakeTileLayers && tmxLoadTextures)
+            BakeTMXTileLayers(map, map->layers, map->layersLength);
+    }
+    return header->texturesLength - header->texturesUploaded;
+}
+
+RAYTMX_DEC TmxParseStats GetParseStatsTMX(void) {
+    LockParseBuffers();
+    TmxParseStats stats = tmxParseStats;
+    UnlockParseBuffers();
+    return stats;
+}
+
+RAYTMX_DEC void UnloadParseBuffersTMX(void) {
+    LockParseBuffers();
+    RaytmxParseBuffer* parseBuffer = tmxParseBuffers;
+    tmxParseBuffers = NULL;
+    tmxParseStats.buffersPooled = 0;
+    tmxParseStats.pooledBytes = 0;
+    UnlockParseBuffers();
+
+    while (parseBuffer != NULL) {
+        RaytmxParseBuffer* next = parseBuffer->next;
+        MemFree(parseBuffer->parserMemory);
+        MemFree(parseBuffer); /* Also frees 'content', which was allocated along with it */
+        parseBuffer = next;
+    }
+}
+
 /**********************************************************************************************************************/
 /* Private implementation.                                                                                            */
 
 RaytmxExternalTileset LoadTSX(const char* fileName) {
+    /* If the tileset was already parsed by PrefetchTMX(), take it and give it its textures */
+    RaytmxPrefetchEntry* prefetched = FindPrefetchEntry(tmxPrefetch, PREFETCH_TSX, fileName);
+    if (prefetched != NULL) {
+        prefetched->isClaimed = true;
+        if (prefetched->externalTileset.isSuccess) {
+            char documentDirectory[512];
+            StringCopy(documentDirectory, GetDirectoryPath2(fileName));
+            LoadTilesetTextures(&prefetched->externalTileset.tileset, documentDirectory);
+        }
+        return prefetched->externalTileset;
+    }
+
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TSX;
@@ -1416,8 +2059,10 @@ RaytmxExternalTileset LoadTSX(const char* fileName) {
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
+    if (!raytmxState->isSuccess) {
+        FreeState(raytmxState); /* Release whatever was parsed before the failure */
         return externalTileset; /* Will have 'isSuccess' set to false to indicate a failure */
+    }
 
     if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
         /* Copy the root tileset so it can be returned */
@@ -1439,6 +2084,18 @@ RaytmxExternalTileset LoadTSX(const char* fileName) {
 }
 
 RaytmxObjectTemplate LoadTX(const char* fileName) {
+    /* If the template was already parsed by PrefetchTMX(), take it and give its tileset, if any, its textures */
+    RaytmxPrefetchEntry* prefetched = FindPrefetchEntry(tmxPrefetch, PREFETCH_TX, fileName);
+    if (prefetched != NULL) {
+        prefetched->isClaimed = true;
+        if (prefetched->objectTemplate.hasTileset) {
+            char documentDirectory[512];
+            StringCopy(documentDirectory, GetDirectoryPath2(fileName));
+            LoadTilesetTextures(&prefetched->objectTemplate.tileset, documentDirectory);
+        }
+        return prefetched->objectTemplate;
+    }
+
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TX;
@@ -1450,8 +2107,10 @@ RaytmxObjectTemplate LoadTX(const char* fileName) {
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
+    if (!raytmxState->isSuccess) {
+        FreeState(raytmxState); /* Release whatever was parsed before the failure */
         return objectTemplate; /* Will have 'isSuccess' set to false to indicate a failure */
+    }
 
     if (raytmxState->objectsRoot != NULL) { /* If there is at least one object */
         /* Copy the root object so it can be returned */
@@ -1486,19 +2145,24 @@ RaytmxObjectTemplate LoadTX(const char* fileName) {
 }
 
 void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
-    char* content = LoadFileText(fileName);
-    if (content == NULL) {
+    /* The document is read, and fed to hoxml, RAYTMX_STREAM_CHUNK bytes at a time. Large <data> contents are handed */
+    /* over in chunks too (see HandleElementBegin()) so hoxml's buffer only has to hold the stack of open elements. */
+    /* Memory used while parsing stays about the same no matter how large the document is. */
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL) {
         TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", fileName);
         return;
     }
-    size_t contentLength = strlen(content);
 
     StringCopy(raytmxState->documentDirectory, GetDirectoryPath2(fileName));
 
+    RaytmxParseBuffer* parseBuffer = BorrowParseBuffer();
+    char* content = parseBuffer->content;
+    size_t contentLength = fread(content, 1, RAYTMX_STREAM_CHUNK, file);
+
     hoxml_context_t hoxmlContext[1];
-    size_t bufferLength = contentLength;
-    char* buffer = (char*)MemAlloc((unsigned int)bufferLength);
-    hoxml_init(hoxmlContext, buffer, bufferLength);
+    hoxml_init(hoxmlContext, parseBuffer->parserMemory, parseBuffer->parserMemoryLength);
+    uint32_t timesGrown = 0;
 
     hoxml_code_t code;
     while ((code = hoxml_parse(hoxmlContext, content, contentLength)) != HOXML_END_OF_DOCUMENT) {
@@ -1506,7 +2170,8 @@ void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
             switch (code) {
             case HOXML_ELEMENT_BEGIN: HandleElementBegin(raytmxState, hoxmlContext); break;
             case HOXML_ELEMENT_END: HandleElementEnd(raytmxState, hoxmlContext); break;
-            case HOXML_ATTRIBUTE: HandleAttribute(raytmxState, hoxmlContext);
+            case HOXML_ATTRIBUTE: HandleAttribute(raytmxState, hoxmlContext); break;
+            case HOXML_CONTENT_CHUNK: HandleContentChunk(raytmxState, hoxmlContext); break;
             case HOXML_PROCESSING_INSTRUCTION_BEGIN: break;
             case HOXML_PROCESSING_INSTRUCTION_END: break;
             default: break; /* No other cases to handle but compilers like to complain */
@@ -1516,13 +2181,19 @@ void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
             case HOXML_ERROR_INSUFFICIENT_MEMORY: {
                 /* This is one we can recover from by expanding the buffer. In this case, it will be doubled. */
                 TraceLog(LOG_DEBUG, "RAYTMX: Allocating a new XML parsing buffer due to insufficient memory");
-                bufferLength *= 2;
-                char* newBuffer = (char*)MemAlloc((unsigned int)bufferLength);
-                hoxml_realloc(hoxmlContext, newBuffer, bufferLength);
-                MemFree(buffer);
-                buffer = newBuffer;
+                size_t newLength = parseBuffer->parserMemoryLength * 2;
+                char* newMemory = (char*)MemAlloc((unsigned int)newLength);
+                hoxml_realloc(hoxmlContext, newMemory, newLength);
+                MemFree(parseBuffer->parserMemory);
+                parseBuffer->parserMemory = newMemory;
+                parseBuffer->parserMemoryLength = newLength;
+                timesGrown++;
                 continue;
             } case HOXML_ERROR_UNEXPECTED_EOF:
+                /* This one is recoverable too, by reading the next part of the document into the same memory */
+                contentLength = fread(content, 1, RAYTMX_STREAM_CHUNK, file);
+                if (contentLength > 0)
+                    continue;
                 TraceLog(LOG_ERROR, "RAYTMX: Unexpected end of file");
             break;
             case HOXML_ERROR_SYNTAX:
@@ -1544,31 +2215,138 @@ void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
             break;
             default: break; /* Keep the compiler happy */
             }
-            UnloadFileText(content);
-            return;
+            break;
         }
     }
 
-    UnloadFileText(content);
-    MemFree(buffer);
-    raytmxState->isSuccess = true;
+    if (code == HOXML_END_OF_DOCUMENT)
+        raytmxState->isSuccess = true;
+    fclose(file);
+    ReturnParseBuffer(parseBuffer, timesGrown);
+}
+
+RaytmxParseBuffer* BorrowParseBuffer(void) {
+    /* Documents are parsed with buffers lent out by a pool so a map with many external tilesets and templates, or a */
+    /* game loading one map after another, doesn't allocate (and zero) the same large buffers for every document */
+    LockParseBuffers();
+    RaytmxParseBuffer* parseBuffer = tmxParseBuffers;
+    if (parseBuffer != NULL) {
+        tmxParseBuffers = parseBuffer->next;
+        tmxParseStats.buffersPooled--;
+        tmxParseStats.pooledBytes -= sizeof(RaytmxParseBuffer) + RAYTMX_STREAM_CHUNK + parseBuffer->parserMemoryLength;
+        tmxParseStats.buffersReused++;
+    } else
+        tmxParseStats.buffersAllocated++;
+    tmxParseStats.documentsParsed++;
+    if (tmxParseStats.parserMemorySize < RAYTMX_PARSE_BUFFER_SIZE)
+        tmxParseStats.parserMemorySize = RAYTMX_PARSE_BUFFER_SIZE;
+    size_t parserMemorySize = tmxParseStats.parserMemorySize;
+    UnlockParseBuffers();
+
+    if (parseBuffer == NULL) {
+        parseBuffer = (RaytmxParseBuffer*)MemAlloc((unsigned int)(sizeof(RaytmxParseBuffer) + RAYTMX_STREAM_CHUNK));
+        parseBuffer->content = (char*)(parseBuffer + 1);
+    }
+
+    /* hoxml's memory only has to hold the open elements and the string being parsed, so the most any document has */
+    /* needed so far (i.e. for its deepest nesting and longest name, value, or content chunk) is likely to be enough */
+    /* for the next one too. Starting there saves doubling the memory, and copying it, over and over while parsing. */
+    if (parseBuffer->parserMemoryLength < parserMemorySize) {
+        MemFree(parseBuffer->parserMemory);
+        parseBuffer->parserMemory = (char*)MemAlloc((unsigned int)parserMemorySize);
+        parseBuffer->parserMemoryLength = parserMemorySize;
+    }
+    parseBuffer->next = NULL;
+    return parseBuffer;
+}
+
+void ReturnParseBuffer(RaytmxParseBuffer* parseBuffer, uint32_t timesGrown) {
+    LockParseBuffers();
+    tmxParseStats.buffersGrown += timesGrown;
+    if (tmxParseStats.parserMemorySize < parseBuffer->parserMemoryLength)
+        tmxParseStats.parserMemorySize = parseBuffer->parserMemoryLength;
+    parseBuffer->next = tmxParseBuffers;
+    tmxParseBuffers = parseBuffer;
+    tmxParseStats.buffersPooled++;
+    tmxParseStats.pooledBytes += sizeof(RaytmxParseBuffer) + RAYTMX_STREAM_CHUNK + parseBuffer->parserMemoryLength;
+    UnlockParseBuffers();
+}
+
+void LockParseBuffers(void) {
+#ifdef RAYTMX_THREADS
+    pthread_mutex_lock(&tmxParseBuffersMutex);
+#endif
+}
+
+void UnlockParseBuffers(void) {
+#ifdef RAYTMX_THREADS
+    pthread_mutex_unlock(&tmxParseBuffersMutex);
+#endif
+}
+
+/* Names of the RaytmxToken values, in the same order */
+static const char* const raytmxTokenNames[] = {
+    "", "animation", "backgroundcolor", "bold", "class", "color", "columns", "compression", "data", "draworder",
+    "duration", "ellipse", "encoding", "firstgid", "fontfamily", "frame", "gid", "group", "halign", "height", "id",
+    "image", "imagelayer", "italic", "kerning", "layer", "map", "margin", "name", "object", "objectalignment",
+    "objectgroup", "offsetx", "offsety", "opacity", "orientation", "parallaxoriginx", "parallaxoriginy", "parallaxx",
+    "parallaxy", "pixelsize", "point", "points", "polygon", "polyline", "properties", "property", "renderorder",
+    "repeatx", "repeaty", "rotation", "source", "spacing", "strikeout", "template", "text", "tile", "tilecount",
+    "tileheight", "tileid", "tileoffset", "tileset", "tilewidth", "tintcolor", "trans", "type", "underline", "valign",
+    "value", "visible", "width", "wrap", "x", "y"
+};
+
+/* Maps each name's hash, see GetToken(), to its RaytmxToken. The hash's multipliers were searched for so that every */
+/* name in raytmxTokenNames[] lands in a slot of its own, so adding a name means checking that still holds. */
+static const uint8_t raytmxTokenSlots[256] = {
+     0,  0, 45,  0,  0,  0,  0,  0,  0,  0,  0, 51,  0,  0,  0,  0,
+     0,  0,  0, 32,  0, 33,  0, 17,  0,  0, 72,  0,  0,  0,  0,  0,
+    47,  0,  0, 35,  0,  0,  0, 31,  0, 24,  0,  0,  0,  0,  0, 66,
+    28,  0,  0,  0,  0,  0,  0,  0,  0,  1, 44,  0, 40,  0, 69, 11,
+     0,  0,  0,  0,  0,  0,  0, 73,  0,  0, 50,  0,  0,  0, 67,  0,
+    19,  0,  0, 16,  0, 34,  8, 30, 64,  4,  0,  0,  0,  0,  3,  0,
+     0,  0, 38,  0, 39,  0,  0,  0,  0,  0, 15, 53,  0, 52, 56,  0,
+     0,  0,  0,  0,  0,  0, 54,  0, 10,  0,  0,  0, 18, 71, 25,  0,
+     0, 29, 13,  0,  0,  0,  0,  0,  0,  0, 42,  5,  2,  6, 68, 27,
+     0,  0,  0,  0,  0,  0, 63, 21,  0,  0, 57,  0, 14,  0, 46,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 59,  0,  0,  0,
+     0,  0, 62,  0,  0,  0, 43,  0, 48, 12, 49,  0,  0,  0, 36,  0,
+    37,  0,  0, 70,  0,  0,  0,  0,  0, 23,  0,  7,  0,  0, 61,  0,
+     0,  0,  0,  0, 58,  0,  0,  0,  0,  0,  0,  0, 55,  0, 65,  0,
+     0,  0,  0, 20,  0, 26,  0,  0,  0,  0,  0,  0,  0,  0,  0, 22,
+    60,  0,  0,  0,  0,  0,  9,  0,  0,  0,  0,  0,  0,  0, 41,  0
+};
+
+/* Look up the token for an element or attribute name. The hash of a known name picks out its token directly and one */
+/* comparison confirms it, or finds it's some other name, so handlers switch on integers rather than comparing names */
+/* one after another. */
+RaytmxToken GetToken(const char* name) {
+    size_t length = strlen(name);
+    if (length == 0)
+        return TOKEN_UNKNOWN;
+
+    uint32_t hash = 2 * (uint32_t)length + 15 * (uint32_t)(unsigned char)name[0] +
+        2 * (uint32_t)(unsigned char)name[length - 1] + 28 * (uint32_t)(unsigned char)name[length / 2];
+    RaytmxToken token = (RaytmxToken)raytmxTokenSlots[hash & 0xFF];
+    return strcmp(name, raytmxTokenNames[token]) == 0 ? token : TOKEN_UNKNOWN;
 }
 
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     if (raytmxState == NULL || hoxmlContext == NULL)
         return;
 
-    if (strcmp(hoxmlContext->tag, "map") == 0)
+    RaytmxToken element = GetToken(hoxmlContext->tag);
+    if (element == TOKEN_MAP)
         ;
-    else if (strcmp(hoxmlContext->tag, "properties") == 0) {
+    else if (element == TOKEN_PROPERTIES) {
         /* TMX allows nested properties but they are not (currently?) supported. To avoid memory leaks <properties> */
         /* depth is tracked. */
         raytmxState->propertiesDepth += 1;
-    } else if (strcmp(hoxmlContext->tag, "property") == 0)
+    } else if (element == TOKEN_PROPERTY)
         raytmxState->property = AddProperty(raytmxState);
-    else if (strcmp(hoxmlContext->tag, "tileset") == 0)
+    else if (element == TOKEN_TILESET)
         raytmxState->tileset = AddTileset(raytmxState);
-    else if (strcmp(hoxmlContext->tag, "image") == 0) {
+    else if (element == TOKEN_IMAGE) {
         /* If any of the elements that may have an image is/are open */
         if (raytmxState->tilesetTile != NULL || raytmxState->tileset != NULL || raytmxState->imageLayer != NULL) {
             /* If the open element already has an image */
@@ -1592,25 +2370,49 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
                 }
             }
         }
-    } /* strcmp(hoxmlContext->tag, "image") == 0 */
-    else if (strcmp(hoxmlContext->tag, "tile") == 0) {
+    } /* element == TOKEN_IMAGE */
+    else if (element == TOKEN_TILE) {
         /* <tile> elements can be children of <tileset> or <layer>. They are also not the same element in that they */
         /* have entirely different attributes and a tileset's <tile> may have children. */
         if (raytmxState->tileset != NULL)
             raytmxState->tilesetTile = AddTilesetTile(raytmxState);
         /* Layer <tile>s are added during attribute handling because they provide a GID attribute and nothing else */
-    } /* strcmp(hoxmlContext->tag, "tile") == 0 */
-    else if (strcmp(hoxmlContext->tag, "animation") == 0) {
+    } /* element == TOKEN_TILE */
+    else if (element == TOKEN_ANIMATION) {
         if (raytmxState->tilesetTile != NULL)
             raytmxState->tilesetTile->hasAnimation = true;
-    } else if (strcmp(hoxmlContext->tag, "frame") == 0)
+    } else if (element == TOKEN_FRAME)
         raytmxState->animationFrame = AddAnimationFrame(raytmxState);
-    else if (strcmp(hoxmlContext->tag, "layer") == 0) {
+    else if (element == TOKEN_LAYER) {
         /* Allocate a new layer with 'tileLayer' allocated and append it to the current group, if it exists */
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ false);
         raytmxState->layer->type = LAYER_TYPE_TILE_LAYER;
         raytmxState->tileLayer = &raytmxState->layer->exact.tileLayer;
-    } else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
+    } else if (element == TOKEN_DATA) {
+        if (raytmxState->tileLayer != NULL) { /* If this <data> applies to a <layer> */
+            TmxTileLayer* tileLayer = raytmxState->tileLayer;
+            if (tileLayer->tiles != NULL) {
+                TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter "
+                    "tiles for this layer will be dropped", raytmxState->layer->name);
+            } else if (tileLayer->width == 0 || tileLayer->height == 0) {
+                TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has no width and/or height - its tiles will be dropped",
+                    raytmxState->layer->name);
+            } else {
+                /* The layer's dimensions were attributes of <layer> so they're already known. Allocate the */
+                /* zeroized tiles array now and let the decoders write the GIDs straight into it. */
+                tileLayer->tilesLength = tileLayer->width * tileLayer->height;
+                tileLayer->tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * tileLayer->tilesLength);
+                raytmxState->layerTiles = tileLayer->tiles;
+                raytmxState->layerTilesLength = 0;
+                raytmxState->layerTilesCapacity = tileLayer->tilesLength;
+                /* Encoded tile data is decoded as it's parsed, rather than held until </data>, so a large layer */
+                /* never has to be in memory as text all at once. It's also decoded right where it was read, */
+                /* without hoxml copying it to its buffer first. */
+                hoxmlContext->content_chunk_length = RAYTMX_STREAM_CHUNK;
+                hoxmlContext->views = HOXML_VIEW_CONTENT;
+            }
+        }
+    } else if (element == TOKEN_OBJECTGROUP) {
         if (raytmxState->tilesetTile != NULL) { /* If the object group is a child of a <tile>, it's collision info */
             raytmxState->objectGroup = &raytmxState->tilesetTile->objectGroup;
             /* Child objects (rectangles, points, ellipses, or polygons) are expected to follow */
@@ -1620,34 +2422,34 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
             raytmxState->layer->type = LAYER_TYPE_OBJECT_GROUP;
             raytmxState->objectGroup = &raytmxState->layer->exact.objectGroup;
         }
-    } else if (strcmp(hoxmlContext->tag, "object") == 0) {
+    } else if (element == TOKEN_OBJECT) {
         /* <object> elements are typically only allowable as children of <objectgroup>s but object templates, TX */
         /* files, contain them as children of root <template> */
         if (raytmxState->objectGroup != NULL || raytmxState->format == FORMAT_TX)
             raytmxState->object = AddObject(raytmxState);
-    } else if (strcmp(hoxmlContext->tag, "ellipse") == 0) {
+    } else if (element == TOKEN_ELLIPSE) {
         if (raytmxState->object != NULL) {
             /* An <ellipse> within an <object> indicates its type but the <object>'s 'x,' 'y,' 'width,' and 'height' */
             /* attributes are used to define the ellipse so assigning the type is all that's necessary */
             raytmxState->object->type = OBJECT_TYPE_ELLIPSE;
         }
-    } else if (strcmp(hoxmlContext->tag, "point") == 0) {
+    } else if (element == TOKEN_POINT) {
         if (raytmxState->object != NULL) {
             /* A <point> within an <object> indicates its type but the <object>'s 'x' and 'y' attributes are used to */
             /* define the point so assigning the type is all that's necessary */
             raytmxState->object->type = OBJECT_TYPE_POINT;
         }
-    } else if (strcmp(hoxmlContext->tag, "polygon") == 0) {
+    } else if (element == TOKEN_POLYGON) {
         if (raytmxState->object != NULL) {
             /* Note: <polygon>s and <polyline>s have a list of points/vertices defined in a 'points' attribute */
             raytmxState->object->type = OBJECT_TYPE_POLYGON;
         }
-    } else if (strcmp(hoxmlContext->tag, "polyline") == 0) {
+    } else if (element == TOKEN_POLYLINE) {
         if (raytmxState->object != NULL) {
             /* Note: <polyline>s and <polygone>s have a list of points/vertices defined in a 'points' attribute */
             raytmxState->object->type = OBJECT_TYPE_POLYLINE;
         }
-    } else if (strcmp(hoxmlContext->tag, "text") == 0) {
+    } else if (element == TOKEN_TEXT) {
         if (raytmxState->object != NULL) {
             raytmxState->object->type = OBJECT_TYPE_TEXT;
             raytmxState->object->text = (TmxText*)MemAllocZero(sizeof(TmxText));
@@ -1657,12 +2459,12 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
             raytmxState->object->text->kerning = 1;
             /* The font family will also default to "sans-serif" when the element ends if there is no attribute */
         }
-    } else if (strcmp(hoxmlContext->tag, "imagelayer") == 0) {
+    } else if (element == TOKEN_IMAGELAYER) {
         /* Allocate a new layer with 'imageLayer' allocated and append it to the current group, if it exists */
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ false);
         raytmxState->layer->type = LAYER_TYPE_IMAGE_LAYER;
         raytmxState->imageLayer = &raytmxState->layer->exact.imageLayer;
-    } else if (strcmp(hoxmlContext->tag, "group") == 0) {
+    } else if (element == TOKEN_GROUP) {
         /* Allocate a new layer and append it to the current group, if it exists */
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ true);
         raytmxState->layer->type = LAYER_TYPE_GROUP;
@@ -1673,8 +2475,10 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     if (raytmxState == NULL || hoxmlContext == NULL)
         return;
 
-    if (strcmp(hoxmlContext->tag, "map") == 0) {
-        if (strcmp(hoxmlContext->attribute, "orientation") == 0) {
+    RaytmxToken element = GetToken(hoxmlContext->tag);
+    RaytmxToken attribute = GetToken(hoxmlContext->attribute);
+    if (element == TOKEN_MAP) {
+        if (attribute == TOKEN_ORIENTATION) {
             if (strcmp(hoxmlContext->value, "orthogonal") == 0)
                 raytmxState->mapOrientation = ORIENTATION_ORTHOGONAL;
             else if (strcmp(hoxmlContext->value, "isometric") == 0)
@@ -1683,8 +2487,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 raytmxState->mapOrientation = ORIENTATION_STAGGERED;
             else if (strcmp(hoxmlContext->value, "hexagonal") == 0)
                 raytmxState->mapOrientation = ORIENTATION_HEXAGONAL;
-        } /* strcmp(hoxmlContext->attribute, "orientation") == 0 */
-        else if (strcmp(hoxmlContext->attribute, "renderorder") == 0) {
+        } /* attribute == TOKEN_ORIENTATION */
+        else if (attribute == TOKEN_RENDERORDER) {
             if (strcmp(hoxmlContext->value, "right-down") == 0)
                 raytmxState->mapRenderOrder = RENDER_ORDER_RIGHT_DOWN;
             else if (strcmp(hoxmlContext->value, "right-up") == 0)
@@ -1693,30 +2497,30 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 raytmxState->mapRenderOrder = RENDER_ORDER_LEFT_DOWN;
             else if (strcmp(hoxmlContext->value, "left-up") == 0)
                 raytmxState->mapRenderOrder = RENDER_ORDER_LEFT_UP;
-        } /* strcmp(hoxmlContext->attribute, "renderorder") == 0 */
-        else if (strcmp(hoxmlContext->attribute, "width") == 0)
+        } /* attribute == TOKEN_RENDERORDER */
+        else if (attribute == TOKEN_WIDTH)
             raytmxState->mapWidth = atoi(hoxmlContext->value);
-        else if (strcmp(hoxmlContext->attribute, "height") == 0)
+        else if (attribute == TOKEN_HEIGHT)
             raytmxState->mapHeight = atoi(hoxmlContext->value);
-        else if (strcmp(hoxmlContext->attribute, "tilewidth") == 0)
+        else if (attribute == TOKEN_TILEWIDTH)
             raytmxState->mapTileWidth = atoi(hoxmlContext->value);
-        else if (strcmp(hoxmlContext->attribute, "tileheight") == 0)
+        else if (attribute == TOKEN_TILEHEIGHT)
             raytmxState->mapTileHeight = atoi(hoxmlContext->value);
-        else if (strcmp(hoxmlContext->attribute, "parallaxoriginx") == 0)
+        else if (attribute == TOKEN_PARALLAXORIGINX)
             raytmxState->mapParallaxOriginX = atoi(hoxmlContext->value);
-        else if (strcmp(hoxmlContext->attribute, "parallaxoriginy") == 0)
+        else if (attribute == TOKEN_PARALLAXORIGINY)
             raytmxState->mapParallaxOriginY = atoi(hoxmlContext->value);
-        else if (strcmp(hoxmlContext->attribute, "backgroundcolor") == 0) {
+        else if (attribute == TOKEN_BACKGROUNDCOLOR) {
             raytmxState->mapBackgroundColor = GetColorFromHexString(hoxmlContext->value);
             raytmxState->mapHasBackgroundColor = true;
         }
-    } /* strcmp(hoxmlContext->tag, "map") == 0 */
-    else if (strcmp(hoxmlContext->tag, "property") == 0) {
+    } /* element == TOKEN_MAP */
+    else if (element == TOKEN_PROPERTY) {
         if (raytmxState->property != NULL) {
-            if (strcmp(hoxmlContext->attribute, "name") == 0) {
+            if (attribute == TOKEN_NAME) {
                 raytmxState->property->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->property->name, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "type") == 0) {
+            } else if (attribute == TOKEN_TYPE) {
                 if (strcmp(hoxmlContext->value, "string") == 0)
                     raytmxState->property->type = PROPERTY_TYPE_STRING;
                 else if (strcmp(hoxmlContext->value, "int") == 0)
@@ -1733,22 +2537,22 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->property->type = PROPERTY_TYPE_OBJECT;
                 /* TMX documentation also mentions a "class" type but doesn't describe what it is nor does Tiled list */
                 /* it as an option when adding a property. So what is it? Unsupported, that's what. */
-            } /* strcmp(hoxmlContext->attribute, "type") == 0 */
-            else if (strcmp(hoxmlContext->attribute, "value") == 0) {
+            } /* attribute == TOKEN_TYPE */
+            else if (attribute == TOKEN_VALUE) {
                 /* Although unlikley, it's possible that 'value' attribute will be parsed before the 'type' */
                 /* attribute. In that case, doing a cast/conversion now may not be possible. To avoid this, the raw */
                 /* string value is copied to 'stringValue' temporarily, or permanently for string and file types, and */
                 /* the cast/conversion will happen at the end of the element if needed. */
                 raytmxState->property->stringValue = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->property->stringValue, hoxmlContext->value);
-            } /* strcmp(hoxmlContext->attribute, "value") == 0 */
+            } /* attribute == TOKEN_VALUE */
         } /* raytmxState->property != NULL */
-    } /* strcmp(hoxmlContext->tag, "property") == 0 */
-    else if (strcmp(hoxmlContext->tag, "tileset") == 0) {
+    } /* element == TOKEN_PROPERTY */
+    else if (element == TOKEN_TILESET) {
         if (raytmxState->tileset != NULL) {
-            if (strcmp(hoxmlContext->attribute, "firstgid") == 0)
+            if (attribute == TOKEN_FIRSTGID)
                 raytmxState->tileset->firstGid = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "source") == 0) {
+            else if (attribute == TOKEN_SOURCE) {
                 raytmxState->tileset->source = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->source, hoxmlContext->value);
                 /* 'source' points to an external TSX file that defines the majority of the tileset. Try to load it. */
@@ -1767,25 +2571,25 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->tileset->firstGid = tempFirstGid;
                     raytmxState->tileset->source = tempSource;
                 }
-            } else if (strcmp(hoxmlContext->attribute, "name") == 0) {
+            } else if (attribute == TOKEN_NAME) {
                 raytmxState->tileset->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->name, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "class") == 0) {
+            } else if (attribute == TOKEN_CLASS) {
                 raytmxState->tileset->classString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->classString, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "tilewidth") == 0)
+            } else if (attribute == TOKEN_TILEWIDTH)
                 raytmxState->tileset->tileWidth = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "tileheight") == 0)
+            else if (attribute == TOKEN_TILEHEIGHT)
                 raytmxState->tileset->tileHeight = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "spacing") == 0)
+            else if (attribute == TOKEN_SPACING)
                 raytmxState->tileset->spacing = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "margin") == 0)
+            else if (attribute == TOKEN_MARGIN)
                 raytmxState->tileset->margin = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "tilecount") == 0)
+            else if (attribute == TOKEN_TILECOUNT)
                 raytmxState->tileset->tileCount = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "columns") == 0)
+            else if (attribute == TOKEN_COLUMNS)
                 raytmxState->tileset->columns = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "objectalignment") == 0) {
+            else if (attribute == TOKEN_OBJECTALIGNMENT) {
                 if (strcmp(hoxmlContext->value, "unspecified") == 0)
                     raytmxState->tileset->objectAlignment = OBJECT_ALIGNMENT_UNSPECIFIED;
                 else if (strcmp(hoxmlContext->value, "topleft") == 0)
@@ -1808,74 +2612,74 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->tileset->objectAlignment = OBJECT_ALIGNMENT_BOTTOM_RIGHT;
             }
         } /* raytmState->tileset != NULL */
-    } /* strcmp(hoxmlContext->tag, "tileset") == 0 */
-    else if (strcmp(hoxmlContext->tag, "tileoffset") == 0) {
+    } /* element == TOKEN_TILESET */
+    else if (element == TOKEN_TILEOFFSET) {
         if (raytmxState->tileset != NULL) {
-            if (strcmp(hoxmlContext->attribute, "x") == 0)
+            if (attribute == TOKEN_X)
                 raytmxState->tileset->tileOffsetX = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "y") == 0)
+            else if (attribute == TOKEN_Y)
                 raytmxState->tileset->tileOffsetY = atoi(hoxmlContext->value);
         }
-    } /* strcmp(hoxmlContext->tag, "tileoffset") == 0 */
-    else if (strcmp(hoxmlContext->tag, "image") == 0) {
+    } /* element == TOKEN_TILEOFFSET */
+    else if (element == TOKEN_IMAGE) {
         if (raytmxState->image != NULL) {
-            if (strcmp(hoxmlContext->attribute, "source") == 0) {
+            if (attribute == TOKEN_SOURCE) {
                 raytmxState->image->source = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->image->source, hoxmlContext->value);
                 RaytmxCachedTextureNode* cachedTexture = LoadCachedTexture(raytmxState, hoxmlContext->value);
                 if (cachedTexture != NULL)
                      raytmxState->image->texture = cachedTexture->texture;
-            } else if (strcmp(hoxmlContext->attribute, "trans") == 0) {
+            } else if (attribute == TOKEN_TRANS) {
                 raytmxState->image->trans = GetColorFromHexString(hoxmlContext->value);
                 raytmxState->image->hasTrans = true;
-            } else if (strcmp(hoxmlContext->attribute, "width") == 0)
+            } else if (attribute == TOKEN_WIDTH)
                 raytmxState->image->width = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "height") == 0)
+            else if (attribute == TOKEN_HEIGHT)
                 raytmxState->image->height = atoi(hoxmlContext->value);
         }
-    } /* strcmp(hoxmlContext->tag, "image") == 0 */
-    else if (strcmp(hoxmlContext->tag, "tile") == 0) {
+    } /* element == TOKEN_IMAGE */
+    else if (element == TOKEN_TILE) {
         if (raytmxState->tilesetTile != NULL) { /* If the <tile> corresponds to a tileset tile */
-            if (strcmp(hoxmlContext->attribute, "id") == 0)
+            if (attribute == TOKEN_ID)
                 raytmxState->tilesetTile->id = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "type") == 0 || strcmp(hoxmlContext->attribute, "class") == 0)
+            else if (attribute == TOKEN_TYPE || attribute == TOKEN_CLASS)
                 raytmxState->tilesetTile->id = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "x") == 0)
+            else if (attribute == TOKEN_X)
                 raytmxState->tilesetTile->x = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "y") == 0)
+            else if (attribute == TOKEN_Y)
                 raytmxState->tilesetTile->y = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "width") == 0)
+            else if (attribute == TOKEN_WIDTH)
                 raytmxState->tilesetTile->width = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "height") == 0)
+            else if (attribute == TOKEN_HEIGHT)
                 raytmxState->tilesetTile->height = atoi(hoxmlContext->value);
         } else { /* If the <tile> corresponds to a layer tile */
-            if (strcmp(hoxmlContext->attribute, "gid") == 0)
+            if (attribute == TOKEN_GID)
                 AddTileLayerTile(raytmxState, atoi(hoxmlContext->value));
         }
-    } /* strcmp(hoxmlContext->tag, "tile") == 0 */
-    else if (strcmp(hoxmlContext->tag, "frame") == 0) {
+    } /* element == TOKEN_TILE */
+    else if (element == TOKEN_FRAME) {
         if (raytmxState->animationFrame != NULL) {
-            if (strcmp(hoxmlContext->attribute, "tileid") == 0)
+            if (attribute == TOKEN_TILEID)
                 raytmxState->animationFrame->id = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "duration") == 0)
+            else if (attribute == TOKEN_DURATION)
                 raytmxState->animationFrame->duration = (float)atoi(hoxmlContext->value) / 1000.0f;
         }
-    } /* strcmp(hoxmlContext->tag, "frame") == 0 */
-    else if (strcmp(hoxmlContext->tag, "layer") == 0) {
+    } /* element == TOKEN_FRAME */
+    else if (element == TOKEN_LAYER) {
         if (raytmxState->tileLayer != NULL) {
             /* Check for attributes specific to <layer> layers */
-            if (strcmp(hoxmlContext->attribute, "width") == 0)
+            if (attribute == TOKEN_WIDTH)
                 raytmxState->tileLayer->width = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "height") == 0)
+            else if (attribute == TOKEN_HEIGHT)
                 raytmxState->tileLayer->height = atoi(hoxmlContext->value);
         }
-    } /* strcmp(hoxmlContext->tag, "layer") == 0) */
-    else if (strcmp(hoxmlContext->tag, "data") == 0) {
+    } /* element == TOKEN_LAYER) */
+    else if (element == TOKEN_DATA) {
         if (raytmxState->tileLayer != NULL) { /* If this <data> applies to a <layer> */
-            if (strcmp(hoxmlContext->attribute, "encoding") == 0) {
+            if (attribute == TOKEN_ENCODING) {
                 raytmxState->tileLayer->encoding = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileLayer->encoding, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "compression") == 0) {
+            } else if (attribute == TOKEN_COMPRESSION) {
                 raytmxState->tileLayer->compression =
                     (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileLayer->compression, hoxmlContext->value);
@@ -1884,61 +2688,61 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* TODO (?): The TMX map format documentation says an <image> can contain a <data> element but doesn't */
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
         }
-    } /* strcmp(hoxmlContext->tag, "data") == 0 */
-    else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
+    } /* element == TOKEN_DATA */
+    else if (element == TOKEN_OBJECTGROUP) {
         if (raytmxState->objectGroup != NULL) {
             /* Check for attributes specific to <objectgroup> layers */
-            if (strcmp(hoxmlContext->attribute, "color") == 0) {
+            if (attribute == TOKEN_COLOR) {
                 raytmxState->objectGroup->color = GetColorFromHexString(hoxmlContext->value);
                 raytmxState->objectGroup->hasColor = true;
-            } /* else if (strcmp(hoxmlContext->attribute, "width") == 0)
+            } /* else if (attribute == TOKEN_WIDTH)
                 raytmxState->objectGroup->width = atoi(hoxmlContext->value); */ /* "Meaningless" according to docs. */
-            /* else if (strcmp(hoxmlContext->attribute, "height") == 0)
+            /* else if (attribute == TOKEN_HEIGHT)
                 raytmxState->objectGroup->height = atoi(hoxmlContext->value); */ /* "Meaningless" according to docs. */
-           else if (strcmp(hoxmlContext->attribute, "draworder") == 0) {
+           else if (attribute == TOKEN_DRAWORDER) {
                 if (strcmp(hoxmlContext->value, "index") == 0)
                     raytmxState->objectGroup->drawOrder = OBJECT_GROUP_DRAW_ORDER_INDEX;
                 else if (strcmp(hoxmlContext->value, "topdown") == 0)
                     raytmxState->objectGroup->drawOrder = OBJECT_GROUP_DRAW_ORDER_TOP_DOWN;
            }
         }
-    } /* strcmp(hoxmlContext->tag, "objectgroup") == 0 */
-    else if (strcmp(hoxmlContext->tag, "object") == 0) {
+    } /* element == TOKEN_OBJECTGROUP */
+    else if (element == TOKEN_OBJECT) {
         if (raytmxState->object != NULL) {
-            if (strcmp(hoxmlContext->attribute, "id") == 0)
+            if (attribute == TOKEN_ID)
                 raytmxState->object->id = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "name") == 0) {
+            else if (attribute == TOKEN_NAME) {
                 raytmxState->object->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->name, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "type") == 0) {
+            } else if (attribute == TOKEN_TYPE) {
                 raytmxState->object->typeString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->typeString, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "x") == 0)
+            } else if (attribute == TOKEN_X)
                 raytmxState->object->x = atof(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "y") == 0)
+            else if (attribute == TOKEN_Y)
                 raytmxState->object->y = atof(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "width") == 0)
+            else if (attribute == TOKEN_WIDTH)
                 raytmxState->object->width = atof(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "height") == 0)
+            else if (attribute == TOKEN_HEIGHT)
                 raytmxState->object->height = atof(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "rotation") == 0)
+            else if (attribute == TOKEN_ROTATION)
                 raytmxState->object->rotation = atof(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "gid") == 0) {
+            else if (attribute == TOKEN_GID) {
                 raytmxState->object->gid = atoi(hoxmlContext->value);
                 /* The presence of a 'gid' attribute also indicates the object's type is that of a tile */
                 raytmxState->object->type = OBJECT_TYPE_TILE;
-            } else if (strcmp(hoxmlContext->attribute, "visible") == 0)
+            } else if (attribute == TOKEN_VISIBLE)
                 raytmxState->object->visible = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "template") == 0) {
+            else if (attribute == TOKEN_TEMPLATE) {
                 raytmxState->object->templateString =
                     (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->templateString, hoxmlContext->value);
             }
         }
-    } /* strcmp(hoxmlContext->tag, "object") == 0 */
-    else if (strcmp(hoxmlContext->tag, "polygon") == 0 || strcmp(hoxmlContext->tag, "polyline") == 0) {
+    } /* element == TOKEN_OBJECT */
+    else if (element == TOKEN_POLYGON || element == TOKEN_POLYLINE) {
         /* <polygon> and <polyline>, children of <object>, both have just one attribute: 'points' */
-        if (raytmxState->object != NULL && strcmp(hoxmlContext->attribute, "points") == 0) {
+        if (raytmxState->object != NULL && attribute == TOKEN_POINTS) {
             if (raytmxState->object->points != NULL) { /* If there's already an array of points */
                 TraceLog(LOG_WARNING, "RAYTMX: object \"%s\", has multiple 'points' attributes; points listed in any "
                     "latter 'points' attributes will be dropped", raytmxState->object->name);
@@ -1975,7 +2779,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 StringCopyN(y, iterator, terminator - iterator); /* Copy 'iterator' up to but excluding 'terminator' */
                 y[terminator - iterator] = '\0';
                 /* Create a linked list node to hold the point and append it to the linked list */
-                RaytmxPolyPointNode* node = (RaytmxPolyPointNode*)MemAllocZero(sizeof(RaytmxPolyPointNode));
+                RaytmxPolyPointNode* node =
+                    (RaytmxPolyPointNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxPolyPointNode));
                 /* Note: These values may be negative. A poly(gon|line) object's position is determined by the first */
                 /* vertex added leading to the first entry to be "0,0" and all other vertices relative to it. */
                 node->point.x = (float)atof(x);
@@ -1995,7 +2800,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 /* The first vertex will be duplicated and appended to the end of the list, for drawing purposes, so */
                 /* the length of the points list is incremented by one */
                 pointsLength += 1;
-                bool isPolygon = strcmp(hoxmlContext->tag, "polygon") == 0;
+                bool isPolygon = element == TOKEN_POLYGON;
                 if (isPolygon) { /* If the object is a polygon, not polyline */
                     /* Polygons will be drawn using raylib's DrawTriangleFan() function in which the first point is */
                     /* the centroid. It must also end with the first, non-centroid point. So, for polygons, the list */
@@ -2010,15 +2815,13 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     points[0].x = vertexSum.x / (pointsLength - 2);
                     points[0].y = vertexSum.y / (pointsLength - 2);
                 }
-                /* Copy the points as Vector2s into the array and free the nodes while we're at it */
+                /* Copy the points as Vector2s into the array. The nodes are left to the arena. */
                 RaytmxPolyPointNode* iteratorNode = pointsRoot;
                 uint32_t i = isPolygon ? 1 : 0; /* Skip over the first element, the centroid, for polygons only */
                 while (iteratorNode != NULL) {
                     points[i] = iteratorNode->point;
-                    RaytmxPolyPointNode* parent = iteratorNode;
                     iteratorNode = iteratorNode->next;
                     i += 1;
-                    MemFree(parent);
                 }
                 /* End the list with the first point. Both polygons and polylines use this when drawing. */
                 points[pointsLength - 1].x = points[isPolygon ? 1 : 0].x;
@@ -2029,31 +2832,31 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 raytmxState->object->pointsLength = pointsLength;
                 raytmxState->object->drawPoints = (Vector2*)MemAllocZero(sizeof(Vector2) * pointsLength);
             }
-        } /* raytmxState->object != NULL && strcmp(hoxmlContext->attribute, "points") == 0 */
-    } /* strcmp(hoxmlContext->tag, "polygon") == 0 || strcmp(hoxmlContext->tag, "polyline") == 0 */
-    else if (strcmp(hoxmlContext->tag, "text") == 0) {
+        } /* raytmxState->object != NULL && attribute == TOKEN_POINTS */
+    } /* element == TOKEN_POLYGON || element == TOKEN_POLYLINE */
+    else if (element == TOKEN_TEXT) {
         if (raytmxState->object != NULL && raytmxState->object->text != NULL) {
-            if (strcmp(hoxmlContext->attribute, "fontfamily") == 0) {
+            if (attribute == TOKEN_FONTFAMILY) {
                 raytmxState->object->text->fontFamily =
                     (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->text->fontFamily, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "pixelsize") == 0)
+            } else if (attribute == TOKEN_PIXELSIZE)
                 raytmxState->object->text->pixelSize = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "wrap") == 0)
+            else if (attribute == TOKEN_WRAP)
                 raytmxState->object->text->wrap = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "color") == 0)
+            else if (attribute == TOKEN_COLOR)
                 raytmxState->object->text->color = GetColorFromHexString(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "bold") == 0)
+            else if (attribute == TOKEN_BOLD)
                 raytmxState->object->text->bold = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "italic") == 0)
+            else if (attribute == TOKEN_ITALIC)
                 raytmxState->object->text->italic = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "underline") == 0)
+            else if (attribute == TOKEN_UNDERLINE)
                 raytmxState->object->text->underline = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "strikeout") == 0)
+            else if (attribute == TOKEN_STRIKEOUT)
                 raytmxState->object->text->strikeOut = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "kerning") == 0)
+            else if (attribute == TOKEN_KERNING)
                 raytmxState->object->text->kerning = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "halign") == 0) {
+            else if (attribute == TOKEN_HALIGN) {
                 if (strcmp(hoxmlContext->value, "left") == 0)
                     raytmxState->object->text->halign = HORIZONTAL_ALIGNMENT_LEFT;
                 else if (strcmp(hoxmlContext->value, "center") == 0)
@@ -2062,7 +2865,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->object->text->halign = HORIZONTAL_ALIGNMENT_RIGHT;
                 else if (strcmp(hoxmlContext->value, "justify") == 0)
                     raytmxState->object->text->halign = HORIZONTAL_ALIGNMENT_JUSTIFY;
-            } else if (strcmp(hoxmlContext->attribute, "valign") == 0) {
+            } else if (attribute == TOKEN_VALIGN) {
                 if (strcmp(hoxmlContext->value, "top") == 0)
                     raytmxState->object->text->valign = VERTICAL_ALIGNMENT_TOP;
                 else if (strcmp(hoxmlContext->value, "center") == 0)
@@ -2071,56 +2874,67 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->object->text->valign = VERTICAL_ALIGNMENT_BOTTOM;
             }
         } /* raytmxState->object != NULL && raytmxState->object->text != NULL */
-    } /* strcmp(hoxmlContext->tag, "text") == 0 */
-    else if (strcmp(hoxmlContext->tag, "imagelayer") == 0) {
+    } /* element == TOKEN_TEXT */
+    else if (element == TOKEN_IMAGELAYER) {
         if (raytmxState->imageLayer != NULL) {
             /* Check for attributes specific to <imagelayer> layers */
-            if (strcmp(hoxmlContext->attribute, "repeatx") == 0)
+            if (attribute == TOKEN_REPEATX)
                 raytmxState->imageLayer->repeatX = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "repeaty") == 0)
+            else if (attribute == TOKEN_REPEATY)
                 raytmxState->imageLayer->repeatY = atoi(hoxmlContext->value) != 0 ? true : false;
         }
-    } /* strcmp(hoxmlContext->tag, "imagelayer") == 0 */
+    } /* element == TOKEN_IMAGELAYER */
 
-    if (strcmp(hoxmlContext->tag, "layer") == 0 || strcmp(hoxmlContext->tag, "objectgroup") == 0 ||
-            strcmp(hoxmlContext->tag, "imagelayer") == 0 || strcmp(hoxmlContext->tag, "group") == 0) {
+    if (element == TOKEN_LAYER || element == TOKEN_OBJECTGROUP ||
+            element == TOKEN_IMAGELAYER || element == TOKEN_GROUP) {
         if (raytmxState->layer != NULL) {
             /* Check for attributes common to all layer types */
-            if (strcmp(hoxmlContext->attribute, "id") == 0)
+            if (attribute == TOKEN_ID)
                 raytmxState->layer->id = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "name") == 0) {
+            else if (attribute == TOKEN_NAME) {
                 raytmxState->layer->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->layer->name, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "class") == 0) {
+            } else if (attribute == TOKEN_CLASS) {
                 raytmxState->layer->classString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->layer->classString, hoxmlContext->value);
-            } else if (strcmp(hoxmlContext->attribute, "opacity") == 0)
+            } else if (attribute == TOKEN_OPACITY)
                 raytmxState->layer->opacity = atof(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "visible") == 0)
+            else if (attribute == TOKEN_VISIBLE)
                 raytmxState->layer->visible = atoi(hoxmlContext->value) != 0 ? true : false;
-            else if (strcmp(hoxmlContext->attribute, "tintcolor") == 0) {
+            else if (attribute == TOKEN_TINTCOLOR) {
                 raytmxState->layer->tintColor = GetColorFromHexString(hoxmlContext->value);
                 raytmxState->layer->hasTintColor = true;
-            } else if (strcmp(hoxmlContext->attribute, "offsetx") == 0)
+            } else if (attribute == TOKEN_OFFSETX)
                 raytmxState->layer->offsetX = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "offsety") == 0)
+            else if (attribute == TOKEN_OFFSETY)
                 raytmxState->layer->offsetY = atoi(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "parallaxx") == 0)
+            else if (attribute == TOKEN_PARALLAXX)
                 raytmxState->layer->parallaxX = atof(hoxmlContext->value);
-            else if (strcmp(hoxmlContext->attribute, "parallaxy") == 0)
+            else if (attribute == TOKEN_PARALLAXY)
                 raytmxState->layer->parallaxY = atof(hoxmlContext->value);
         }
-    } /* strcmp(hoxmlContext->tag, "layer") == 0 || strcmp(hoxmlContext->tag, "objectgroup") == 0 || */
-      /* strcmp(hoxmlContext->tag, "imagelayer") == 0 || strcmp(hoxmlContext->tag, "group") == 0 */
+    } /* element == TOKEN_LAYER || element == TOKEN_OBJECTGROUP || */
+      /* element == TOKEN_IMAGELAYER || element == TOKEN_GROUP */
+}
+
+void HandleContentChunk(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
+    if (raytmxState == NULL || hoxmlContext == NULL)
+        return;
+
+    RaytmxToken element = GetToken(hoxmlContext->tag);
+    /* Chunks are only asked for while a tile layer's <data> is open, see HandleElementBegin() */
+    if (element == TOKEN_DATA && raytmxState->layerTiles != NULL && raytmxState->tileLayer->encoding != NULL)
+        ParseDataContent(raytmxState, hoxmlContext->content_view, hoxmlContext->content_length, /* isFinal: */ false);
 }
 
 void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     if (raytmxState == NULL || hoxmlContext == NULL)
         return;
 
+    RaytmxToken element = GetToken(hoxmlContext->tag);
     /* If the element is one of the layer types which share some common attributes that may need default strings */
-    if (strcmp(hoxmlContext->tag, "layer") == 0 || strcmp(hoxmlContext->tag, "objectgroup") == 0 ||
-            strcmp(hoxmlContext->tag, "imagelayer") == 0 || strcmp(hoxmlContext->tag, "group") == 0) {
+    if (element == TOKEN_LAYER || element == TOKEN_OBJECTGROUP ||
+            element == TOKEN_IMAGELAYER || element == TOKEN_GROUP) {
         TmxLayer* layer = raytmxState->layer;
         if (layer == NULL && raytmxState->groupNode != NULL)
             layer = &raytmxState->groupNode->layer;
@@ -2138,10 +2952,10 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 layer->classString[0] = '\0';
             }
         }
-    } /* strcmp(hoxmlContext->tag, "layer") == 0 || strcmp(hoxmlContext->tag, "objectgroup") == 0 || */
-      /* strcmp(hoxmlContext->tag, "imagelayer") == 0 || strcmp(hoxmlContext->tag, "group") == 0 */
+    } /* element == TOKEN_LAYER || element == TOKEN_OBJECTGROUP || */
+      /* element == TOKEN_IMAGELAYER || element == TOKEN_GROUP */
 
-    if (strcmp(hoxmlContext->tag, "properties") == 0) {
+    if (element == TOKEN_PROPERTIES) {
         if (raytmxState->propertiesRoot == NULL)
             return;
         /* TMX allows nested properties (e.g. <properties><properties><property/></properties></properties>) but */
@@ -2152,13 +2966,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             return;
         /* Allocate the array and assign NULL to every index to be safe */
         TmxProperty* properties = (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * raytmxState->propertiesLength);
-        /* Copy the TmxProperty pointers into the array and free the nodes while we're at it */
+        /* Copy the TmxProperty pointers into the array. The nodes are left to the arena. */
         RaytmxPropertyNode* iterator = raytmxState->propertiesRoot;
         for (uint32_t i = 0; i < raytmxState->propertiesLength; i++) {
             properties[i] = iterator->property;
-            RaytmxPropertyNode* parent = iterator;
             iterator = iterator->next;
-            MemFree(parent);
         }
         /* Add the properties array to the element it applies to */
         /* A <property>, or rather its parent <properties>, can be within 10+ other elements. The order of the checks */
@@ -2193,8 +3005,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         raytmxState->propertiesRoot = NULL;
         raytmxState->propertiesTail = NULL;
         raytmxState->propertiesLength = 0;
-    } /* strcmp(hoxmlContext->tag, "properties") == 0 */
-    else if (strcmp(hoxmlContext->tag, "property") == 0) {
+    } /* element == TOKEN_PROPERTIES */
+    else if (element == TOKEN_PROPERTY) {
         if (raytmxState->property != NULL) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             /* Properties are cast and assigned to type-specific variables at the end of the element due to the order */
@@ -2259,8 +3071,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             }
         }
         raytmxState->property = NULL;
-    } /* strcmp(hoxmlContext->tag, "property") == 0 */
-    else if (strcmp(hoxmlContext->tag, "tileset") == 0) {
+    } /* element == TOKEN_PROPERTY */
+    else if (element == TOKEN_TILESET) {
         if (raytmxState->tileset != NULL) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->tileset->name == NULL) { /* If this <tileset> didn't have a 'name' attribute */
@@ -2285,13 +3097,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 /* Allocate the array and zeroize every index as initialization */
                 TmxTilesetTile* tiles = (TmxTilesetTile*)MemAllocZero(sizeof(TmxTilesetTile) *
                     raytmxState->tilesetTilesLength);
-                /* Copy the TmxTilesetTile pointers into the array and free the nodes while we're at it */
+                /* Copy the TmxTilesetTile pointers into the array. The nodes are left to the arena. */
                 RaytmxTilesetTileNode* iterator = raytmxState->tilesetTilesRoot;
                 for (uint32_t i = 0; i < raytmxState->tilesetTilesLength; i++) {
                     tiles[i] = iterator->tile;
-                    RaytmxTilesetTileNode* parent = iterator;
                     iterator = iterator->next;
-                    MemFree(parent);
                 }
                 /* Add the tiles array to the tileset */
                 raytmxState->tileset->tiles = tiles;
@@ -2303,23 +3113,21 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             }
         }
         raytmxState->tileset = NULL;
-    } /* strcmp(hoxmlContext->tag, "tileset") == 0 */
-    else if (strcmp(hoxmlContext->tag, "image") == 0)
+    } /* element == TOKEN_TILESET */
+    else if (element == TOKEN_IMAGE)
         raytmxState->image = NULL;
-    else if (strcmp(hoxmlContext->tag, "animation") == 0) {
+    else if (element == TOKEN_ANIMATION) {
         if (raytmxState->tilesetTile != NULL && raytmxState->tilesetTile->hasAnimation) {
             if (raytmxState->animationFramesRoot == NULL)
                 return;
             /* Allocate the array and zeroize every index as initialization */
             TmxAnimationFrame* frames = (TmxAnimationFrame*)MemAllocZero(sizeof(TmxAnimationFrame) *
                 raytmxState->animationFramesLength);
-            /* Copy the TmxAnimationFrame pointers into the array and free the nodes while we're at it */
+            /* Copy the TmxAnimationFrame pointers into the array. The nodes are left to the arena. */
             RaytmxAnimationFrameNode* iterator = raytmxState->animationFramesRoot;
             for (uint32_t i = 0; i < raytmxState->animationFramesLength; i++) {
                 frames[i] = iterator->frame;
-                RaytmxAnimationFrameNode* parent = iterator;
                 iterator = iterator->next;
-                MemFree(parent);
             }
             /* Add the frames array to the tile's animation */
             raytmxState->tilesetTile->animation.frames = frames;
@@ -2329,46 +3137,15 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             raytmxState->animationFramesTail = NULL;
             raytmxState->animationFramesLength = 0;
         }
-    } /* strcmp(hoxmlContext->tag, "animation") == 0 */
-    else if (strcmp(hoxmlContext->tag, "frame") == 0)
+    } /* element == TOKEN_ANIMATION */
+    else if (element == TOKEN_FRAME)
         raytmxState->animationFrame = NULL;
-    else if (strcmp(hoxmlContext->tag, "layer") == 0) {
-        if (raytmxState->tileLayer != NULL) {
-            /* If there were 1+ <tile>s within this <layer> but this <layer> already has tiles (from a <data>?) */
-            if (raytmxState->layerTilesRoot != NULL && raytmxState->tileLayer->tiles != NULL) {
-                TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles "
-                    "for this layer will be dropped", raytmxState->layer->name);
-                /* Free the nodes and tiles therein */
-                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
-                while (iterator != NULL) {
-                    RaytmxTileLayerTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
-            } else {
-                /* Allocate the array and zeroize every index as initialization */
-                uint32_t* tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GID into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength; i++) {
-                    tiles[i] = iterator->gid;
-                    RaytmxTileLayerTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
-                /* Add the tiles array to the tile layer */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
-            }
-            /* Clean up the state object */
-            raytmxState->layerTilesRoot = NULL;
-            raytmxState->layerTilesTail = NULL;
-            raytmxState->layerTilesLength = 0;
-        }
+    else if (element == TOKEN_LAYER) {
+        /* The tiles array was filled in place by the <data> element, if any, so there's nothing left to copy */
         raytmxState->tileLayer = NULL;
         raytmxState->layer = NULL;
-    } /* strcmp(hoxmlContext->tag, "layer") == 0 */
-    else if (strcmp(hoxmlContext->tag, "tile") == 0) {
+    } /* element == TOKEN_LAYER */
+    else if (element == TOKEN_TILE) {
         if (raytmxState->tilesetTile != NULL) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->tilesetTile->hasImage) {
@@ -2380,53 +3157,41 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             }
             raytmxState->tilesetTile = NULL;
         }
-    } /* strcmp(hoxmlContext->tag, "tile") == 0 */
-    else if (strcmp(hoxmlContext->tag, "data") == 0) {
+    } /* element == TOKEN_TILE */
+    else if (element == TOKEN_DATA) {
         if (raytmxState->image != NULL) {
             /* TODO (?): The TMX map format documentation says an <image> can contain a <data> element but doesn't */
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
-        } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->tiles != NULL) {
-            TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles for "
-                "this layer will be dropped", raytmxState->layer->name);
-        } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL) {
-            RaytmxTileLayerTileNode* tiles = NULL;
+        } else if (raytmxState->layerTiles != NULL && raytmxState->tileLayer->encoding != NULL) {
+            /* Everything up to the last chunk handed to HandleContentChunk(), if any, was decoded already */
+            ParseDataContent(raytmxState, hoxmlContext->content_view, hoxmlContext->content_length,
+                /* isFinal: */ true);
             if (strcmp(raytmxState->tileLayer->encoding, "base64") == 0) {
-                /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML */
-                /* considers everything between <data> and </data> to be content meaning there is probably some */
-                /* whitespace on both ends of the content we need to ignore. So, find the actual start and stop: */
-                char *encodedStart = hoxmlContext->content, *encodedEnd;
-                while (isspace(*encodedStart))
-                    encodedStart++;
-                encodedEnd = encodedStart + strlen(encodedStart) - 1;
-                while (encodedEnd > encodedStart && isspace(*encodedEnd))
-                    encodedEnd--;
-
-                /* With the string of encoded Base64 data trimmed, decode it */
-                int decodedLength;
-                unsigned char* decoded = DecodeDataBase64((const unsigned char*)encodedStart, &decodedLength);
-                if (decoded != NULL) {
-                    if (raytmxState->tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
-                        /* Iterate through N bytes ('decodedLength') with every four bytes being a single GID */
-                        /* resulting in N / 4 tiles */
-                        uint32_t* iterator = (uint32_t*)decoded;
-                        for (int i = 0; i < decodedLength / 4; i++) {
-                            AddTileLayerTile(raytmxState, *iterator);
-                            iterator += 1; /* Point to the next unsigned, 32-bit integer in the decoded data */
-                        }
-                    } else { /* If the Base-64encoded data is also compressed */
+                if (raytmxState->tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
+                    /* Every four bytes are a single GID, decoded straight into the layer's preallocated tiles */
+                    if (raytmxState->isDataInvalid) {
+                        TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
+                            raytmxState->layer->name);
+                    }
+                    raytmxState->layerTilesLength += (uint32_t)(raytmxState->dataDecodedLength / 4);
+                } else { /* If the Base-64encoded data is also compressed */
+                    unsigned char* decoded = raytmxState->dataDecoded;
+                    size_t decodedLength = raytmxState->dataDecodedLength;
+                    if (!raytmxState->isDataInvalid) {
                         if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0 ||
                                 strcmp(raytmxState->tileLayer->compression, "zlib") == 0) {
-                            unsigned char* postHeaderDecoded = NULL;
+                            size_t headerLength = 0;
                             if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0) {
                                 /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, */
                                 /* identifying the format and the third is expected to indicate the compression */
                                 /* method where 0x08 is DEFLATE. */
                                 /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
+                                if (decodedLength > 10 && decoded[0] == 0x1F && decoded[1] == 0x8B &&
+                                        decoded[2] == 0x08) {
                                     /* Skip past the GZIP header. The header is typically ten bytes. The bytes not */
                                     /* checked are unimportant things like a timestamp and OS ID. Additional optional */
                                     /* headers are possible but not used by Tiled so they are assumed to be missing. */
-                                    postHeaderDecoded = decoded + 10;
+                                    headerLength = 10;
                                 } else { /* If the GZIP header doesn't match a decompressable one */
                                     TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's "
                                         "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
@@ -2436,27 +3201,23 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                 /* DEFLATE compression method and the 7 is "compression info" that indicates a 32K */
                                 /* LZ77 window size and, in practice, cannot be anything else. */
                                 /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x78) {
+                                if (decodedLength > 2 && decoded[0] == 0x78) {
                                     /* Skip past the ZLIB header. The header is two bytes. */
-                                    postHeaderDecoded = decoded + 2;
+                                    headerLength = 2;
                                 } else { /* If the ZLIB header doesn't match a decompressable one */
                                     TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's "
                                         "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
                                 }
                             }
 
-                            if (postHeaderDecoded != NULL) {
+                            if (headerLength > 0) {
                                 /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a */
                                 /* decompression function when it's built with SUPPORT_COMPRESSION_API (default) */
                                 int decompressedLength;
-                                unsigned char* decompressed = DecompressData(postHeaderDecoded, decodedLength,
-                                    &decompressedLength);
+                                unsigned char* decompressed = DecompressData(decoded + headerLength,
+                                    (int)(decodedLength - headerLength), &decompressedLength);
                                 if (decompressed != NULL && decompressedLength > 0) {
-                                    uint32_t* iterator = (uint32_t*)decompressed;
-                                    for (int i = 0; i < decompressedLength / 4; i++) {
-                                        AddTileLayerTile(raytmxState, *iterator);
-                                        iterator += 1; /* Point to the next unsigned integer in the decompressed data */
-                                    }
+                                    AddTileLayerTiles(raytmxState, decompressed, (uint32_t)decompressedLength / 4);
                                     MemFree(decompressed); /* Free the memory allocated by DecompressData() */
                                 } else { /* raylib wasn't built with compression or allocation failed */
                                     TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed "
@@ -2465,58 +3226,46 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                         raytmxState->tileLayer->compression);
                                 }
                             }
+                        } else if (strcmp(raytmxState->tileLayer->compression, "zstd") == 0) {
+#ifdef RAYTMX_SUPPORT_ZSTD
+                            DecompressZstdTiles(raytmxState, decoded, decodedLength);
+#else
+                            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"zstd\" cannot be parsed "
+                                "because raytmx was built without RAYTMX_SUPPORT_ZSTD", raytmxState->layer->name);
+#endif
                         } else {
                             TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method "
                                 "\"%s\" is unsupported", raytmxState->layer->name, raytmxState->tileLayer->compression);
                         }
+                    } else {
+                        TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
+                            raytmxState->layer->name);
                     }
-                    MemFree(decoded); /* Free the memory allocated by DecodeDataBase64() */
-                } else {
-                    TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
-                        raytmxState->layer->name);
                 }
             } /* strcmp(raytmxState->tileLayer->encoding, "base64") == 0 */
-            else if (strcmp(raytmxState->tileLayer->encoding, "csv") == 0) {
-                /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
-                /* "31,32,33" where 31, 32, and 33 are GIDs */
-                char valueAsString[16]; /* Needs to fit all digits of a single value - should be more than enough */
-                char* iterator = hoxmlContext->content;
-                while (*iterator != '\0') { /* While not pointing to the end of the end of the string */
-                    memset(valueAsString, '\0', 16); /* Reset the value-as-a-string buffer with all zeroes */
-                    /* Copy each character into the buffer until either a comma or the terminator is reached */
-                    for (int i = 0; *iterator != ',' && *iterator != '\0'; i++) {
-                        valueAsString[i] = *iterator;
-                        iterator++;
-                    }
-                    if (*iterator == ',') /* If iteration was paused by a comma */
-                        iterator++; /* Advance one character so the comma isn't parsed with the value next iteration */
-                    AddTileLayerTile(raytmxState, atoi(valueAsString)); /* Read the value as an integer GID */
-                }
-            } /* strcmp(raytmxState->tileLayer->encoding, "csv") == 0 */
-
-            if (tiles != NULL) { /* If there was no error in parsing the data and there's a linked list of tiles */
-                /* Allocate the array and assign 0 to every index to be safe */
-                uint32_t* tiles = (uint32_t*)MemAlloc(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                memset(tiles, 0, sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GIDs into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* layerTilesIterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength; i++) {
-                    tiles[i] = layerTilesIterator->gid;
-                    RaytmxTileLayerTileNode* layerTilesTemp = layerTilesIterator;
-                    layerTilesIterator = layerTilesIterator->next;
-                    MemFree(layerTilesTemp);
-                }
-                /* Add the tiles array to the element it applies to */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
-                /* Clean up the state object */
-                raytmxState->layerTilesRoot = NULL;
-                raytmxState->layerTilesTail = NULL;
-                raytmxState->layerTilesLength = 0;
+            MemFree(raytmxState->dataDecoded);
+            raytmxState->dataDecoded = NULL;
+            raytmxState->dataDecodedLength = 0;
+            raytmxState->dataDecodedCapacity = 0;
+            raytmxState->dataCarryLength = 0;
+            raytmxState->isDataInvalid = false;
+        } /* raytmxState->layerTiles != NULL && raytmxState->tileLayer->encoding != NULL */
+        hoxmlContext->content_chunk_length = 0; /* Other elements' content is only needed whole... */
+        hoxmlContext->views = 0; /* ...and null terminated */
+
+        /* Whether the GIDs were encoded or given as <tile> children, the layer's tiles are complete now */
+        if (raytmxState->layerTiles != NULL) {
+            if (raytmxState->layerTilesLength != raytmxState->layerTilesCapacity) {
+                TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has %u tiles but is %ux%u - missing tiles are left empty "
+                    "and extra tiles are dropped", raytmxState->layer->name, raytmxState->layerTilesLength,
+                    raytmxState->tileLayer->width, raytmxState->tileLayer->height);
             }
-        } /* raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL */
-    } /* strcmp(hoxmlContext->tag, "data") == 0 */
-    else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
+            raytmxState->layerTiles = NULL;
+            raytmxState->layerTilesLength = 0;
+            raytmxState->layerTilesCapacity = 0;
+        }
+    } /* element == TOKEN_DATA */
+    else if (element == TOKEN_OBJECTGROUP) {
         if (raytmxState->objectGroup != NULL) {
             if (raytmxState->objectsRoot == NULL)
                 return;
@@ -2524,13 +3273,14 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             TmxObject* objects = (TmxObject*)MemAllocZero(sizeof(TmxObject) * raytmxState->objectsLength);
             uint32_t* ySortedObjects = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->objectsLength);
             /* Create a contiguous array of TmxObjects, create a sorted linked list of indexes within that array of */
-            /* TmxObjects (sorted by ascending y-coordinate), and free the object linked list */
-            RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-            RaytmxObjectSortingNode *sortingRoot = NULL, *sortingIterator, *sortingTemp, *newSortingNode;
+            /* TmxObjects (sorted by ascending y-coordinate). Both lists' nodes are left to the arena. */
+            RaytmxObjectNode* objectsIterator = raytmxState->objectsRoot;
+            RaytmxObjectSortingNode *sortingRoot = NULL, *sortingIterator, *newSortingNode;
             for (uint32_t i = 0; objectsIterator != NULL; i++) {
                 objects[i] = objectsIterator->object;
                 /* Add a new node into the sorted list */
-                newSortingNode = (RaytmxObjectSortingNode*)MemAllocZero(sizeof(RaytmxObjectSortingNode));
+                newSortingNode =
+                    (RaytmxObjectSortingNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxObjectSortingNode));
                 newSortingNode->y = objects[i].y;
                 newSortingNode->index = i;
                 if (sortingRoot == NULL) /* If this is the first node */
@@ -2545,19 +3295,14 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     newSortingNode->next = sortingIterator->next;
                     sortingIterator->next = newSortingNode;
                 }
-                /* Free the object node */
-                objectsTemp = objectsIterator;
                 objectsIterator = objectsIterator->next;
-                MemFree(objectsTemp);
             }
             /* Create a contiguous array from the sorted linked list such that index 0 of this array points to the */
             /* TmxObject (via its index in 'objects') with the lowest (visually, highest) y-coordinate */
             sortingIterator = sortingRoot;
             for (uint32_t i = 0; sortingIterator != NULL; i++) {
                 ySortedObjects[i] = sortingIterator->index;
-                sortingTemp = sortingIterator;
                 sortingIterator = sortingIterator->next;
-                MemFree(sortingTemp);
             }
             /* Add the objects and ySortedObjects array to the object layer */
             raytmxState->objectGroup->objects = objects;
@@ -2570,7 +3315,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         }
         raytmxState->objectGroup = NULL;
         raytmxState->layer = NULL;
-    } else if (strcmp(hoxmlContext->tag, "object") == 0) {
+    } else if (element == TOKEN_OBJECT) {
         if (raytmxState->object != NULL) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->object->name == NULL) { /* If this <object> didn't have a 'name' attribute */
@@ -2642,7 +3387,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                             uint32_t propertiesLength = 0;
                             /* Add the properties from the instanced <object> */
                             for (uint32_t i = 0; i < raytmxState->object->propertiesLength; i++) {
-                                node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                node = (RaytmxPropertyNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxPropertyNode));
                                 node->property = raytmxState->object->properties[i];
                                 if (propertiesRoot == NULL)
                                     propertiesRoot = node;
@@ -2664,7 +3409,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                     propertiesIterator = propertiesIterator->next;
                                 }
                                 if (isNew) {
-                                    node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                    node = (RaytmxPropertyNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxPropertyNode));
                                     node->property = objectTemplate.object.properties[i];
                                     if (propertiesRoot == NULL)
                                         propertiesRoot = node;
@@ -2680,13 +3425,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                             raytmxState->object->properties =
                                 (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * propertiesLength);
                             raytmxState->object->propertiesLength = propertiesLength;
-                            /* Copy the TmxProperty entires into the array and free the nodes while we're at it */
+                            /* Copy the TmxProperty entires into the array. The nodes are left to the arena. */
                             RaytmxPropertyNode* propertiesIterator = propertiesRoot;
                             for (uint32_t i = 0; propertiesIterator != NULL; i++) {
                                 raytmxState->object->properties[i] = propertiesIterator->property;
-                                RaytmxPropertyNode* propertiesTemp = propertiesIterator;
                                 propertiesIterator = propertiesIterator->next;
-                                MemFree(propertiesTemp);
                             }
                         }
                     }
@@ -2745,8 +3488,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             }
         }
         raytmxState->object = NULL;
-    } /* strcmp(hoxmlContext->tag, "object") == 0 */
-    else if (strcmp(hoxmlContext->tag, "text") == 0) {
+    } /* element == TOKEN_OBJECT */
+    else if (element == TOKEN_TEXT) {
         /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
         if (raytmxState->object != NULL && raytmxState->object->text != NULL) {
             TmxObject* object = raytmxState->object;
@@ -2851,7 +3594,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         line.spacing = spacing;
                         /* Note: The number of lines is not yet known but needs to be for Y positioning */
 
-                        RaytmxTextLineNode* node = (RaytmxTextLineNode*)MemAllocZero(sizeof(RaytmxTextLineNode));
+                        RaytmxTextLineNode* node =
+                            (RaytmxTextLineNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxTextLineNode));
                         node->line = line;
                         if (linesRoot == NULL)
                             linesRoot = node;
@@ -2882,7 +3626,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 if (linesRoot != NULL) {
                     /* Allocate the array and zero out every value as initialization */
                     TmxTextLine* lines = (TmxTextLine*)MemAllocZero(sizeof(TmxTextLine) * linesLength);
-                    /* Copy the TmxTextLines into the array and free the nodes while we're at it */
+                    /* Copy the TmxTextLines into the array. The nodes are left to the arena. */
                     RaytmxTextLineNode* iterator = linesRoot;
                     for (uint32_t i = 0; i < linesLength; i++) {
                         lines[i] = iterator->line;
@@ -2958,9 +3702,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         } else /* if (objectText->valign == VERTICAL_ALIGNMENT_TOP) */
                             lines[i].position.y = (float)object->y + (float)(objectText->pixelSize * i);
 
-                        RaytmxTextLineNode* parent = iterator;
                         iterator = iterator->next;
-                        MemFree(parent);
                     }
                     /* Add the lines array to the text object */
                     objectText->lines = lines;
@@ -2968,29 +3710,17 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 }
             } /* objectText->content != NULL */
         }
-    } /* strcmp(hoxmlContext->tag, "text") == 0 */
-    else if (strcmp(hoxmlContext->tag, "imagelayer") == 0) {
+    } /* element == TOKEN_TEXT */
+    else if (element == TOKEN_IMAGELAYER) {
         raytmxState->imageLayer = NULL;
         raytmxState->layer = NULL;
-    } else if (strcmp(hoxmlContext->tag, "group") == 0) {
+    } else if (element == TOKEN_GROUP) {
         /* <group>s can be nested so we must return to processing its parent, if it exists */
         if (raytmxState->groupNode != NULL)
             raytmxState->groupNode = raytmxState->groupNode->parent; /* Will be null when returning to the root map */
     }
 }
 
-void FreeStateLayers(RaytmxLayerNode* layers) {
-    RaytmxLayerNode *layersIterator = layers, *layersTemp;
-    while (layersIterator != NULL) {
-        /* Group layers may have children, forming a tree-like structure. Free the children. */
-        FreeStateLayers(layersIterator->childrenRoot);
-        /* Iterate to the next node and free this one */
-        layersTemp = layersIterator;
-        layersIterator = layersIterator->next;
-        MemFree(layersTemp);
-    }
-}
-
 void FreeState(RaytmxState* raytmxState) {
     if (raytmxState == NULL)
         return;
@@ -3030,82 +3760,31 @@ void FreeState(RaytmxState* raytmxState) {
     raytmxState->imageLayer = NULL;
     raytmxState->object = NULL;
 
-    /* Free each property in the linked list of properties */
-    RaytmxPropertyNode *propertiesIterator = raytmxState->propertiesRoot, *propertiesTemp;
-    while (propertiesIterator != NULL) {
-        propertiesTemp = propertiesIterator;
-        propertiesIterator = propertiesIterator->next;
-        MemFree(propertiesTemp);
-    }
-    /* Zeroize this linked list's properties */
+    /* Only set if parsing stopped partway through compressed <data> */
+    MemFree(raytmxState->dataDecoded);
+    raytmxState->dataDecoded = NULL;
+
+    /* Every linked list node lives in the arena. Release all of them at once and forget the lists. */
+    FreeArena(raytmxState);
     raytmxState->propertiesRoot = NULL;
     raytmxState->propertiesTail = NULL;
     raytmxState->propertiesLength = 0;
-
-    /* Free each node in the linked list of tilesets */
-    RaytmxTilesetNode *tilesetsIterator = raytmxState->tilesetsRoot, *tilesetsTemp;
-    while (tilesetsIterator != NULL) {
-        tilesetsTemp = tilesetsIterator;
-        tilesetsIterator = tilesetsIterator->next;
-        MemFree(tilesetsTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->tilesetsRoot = NULL;
     raytmxState->tilesetsTail = NULL;
     raytmxState->tilesetsLength = 0;
-
-    /* Free each node in the linked list of tileset tiles */
-    RaytmxTilesetTileNode *tilesetTilesIterator = raytmxState->tilesetTilesRoot, *tilesetTilesTemp;
-    while (tilesetTilesIterator != NULL) {
-        tilesetTilesTemp = tilesetTilesIterator;
-        tilesetTilesIterator = tilesetTilesIterator->next;
-        MemFree(tilesetTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->tilesetTilesRoot = NULL;
     raytmxState->tilesetTilesTail = NULL;
     raytmxState->tilesetTilesLength = 0;
-
-    /* Free each node in the linked list of animation frames */
-    RaytmxAnimationFrameNode *animationFramesIterator = raytmxState->animationFramesRoot, *animationFramesTemp;
-    while (animationFramesIterator != NULL) {
-        animationFramesTemp = animationFramesIterator;
-        animationFramesIterator = animationFramesIterator->next;
-        MemFree(animationFramesTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->animationFramesRoot = NULL;
     raytmxState->animationFramesTail = NULL;
     raytmxState->animationFramesLength = 0;
-
-    /* Layers may be groups. The resulting collection isn't a link list as much as it is a tree. So freeing layers is */
-    /* best done with a recursive approach. */
-    FreeStateLayers(raytmxState->layersRoot);
-    /* Zeroize this linked list's properties */
     raytmxState->layersRoot = NULL;
     raytmxState->layersTail = NULL;
+    raytmxState->groupNode = NULL;
     raytmxState->layersLength = 0;
-
-    /* Free each node in the linked list of layer tiles */
-    RaytmxTileLayerTileNode *layerTilesIterator = raytmxState->layerTilesRoot, *layerTilesTemp;
-    while (layerTilesIterator != NULL) {
-        layerTilesTemp = layerTilesIterator;
-        layerTilesIterator = layerTilesIterator->next;
-        MemFree(layerTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->layerTilesRoot = NULL;
-    raytmxState->layerTilesTail = NULL;
+    raytmxState->layerTiles = NULL; /* Owned by its TmxTileLayer, not the state */
     raytmxState->layerTilesLength = 0;
-
-    /* Free each node in the linked list of objects */
-    RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-    while (objectsIterator != NULL) {
-        objectsTemp = objectsIterator;
-        objectsIterator = objectsIterator->next;
-        MemFree(objectsTemp);
-    }
-    /* Zeroize this linked list's properties */
+    raytmxState->layerTilesCapacity = 0;
     raytmxState->objectsRoot = NULL;
     raytmxState->objectsTail = NULL;
     raytmxState->objectsLength = 0;
@@ -3122,7 +3801,8 @@ void FreeTileset(TmxTileset tileset) {
     FreeString(tileset.classString);
     if (tileset.hasImage) {
         FreeString(tileset.image.source);
-        UnloadTexture(tileset.image.texture);
+        if (tileset.image.texture.id != 0) /* Zero if loading failed or textures were disabled */
+            UnloadTexture(tileset.image.texture);
     }
     if (tileset.properties != NULL) {
         for (uint32_t i = 0; i < tileset.propertiesLength; i++)
@@ -3133,7 +3813,8 @@ void FreeTileset(TmxTileset tileset) {
         TmxTilesetTile tile = tileset.tiles[i];
         if (tile.hasImage) {
             FreeString(tile.image.source);
-            UnloadTexture(tile.image.texture);
+            if (tile.image.texture.id != 0)
+                UnloadTexture(tile.image.texture);
             if (tile.properties != NULL) {
                 for (uint32_t j = 0; j < tile.propertiesLength; j++)
                     FreeProperty(tile.properties[j]);
@@ -3170,7 +3851,7 @@ void FreeLayer(TmxLayer layer) {
         MemFree(layer.exact.objectGroup.objects);
     break;
     case LAYER_TYPE_IMAGE_LAYER:
-        if (layer.exact.imageLayer.hasImage)
+        if (layer.exact.imageLayer.hasImage && layer.exact.imageLayer.image.texture.id != 0)
             UnloadTexture(layer.exact.imageLayer.image.texture);
     break;
     case LAYER_TYPE_GROUP: break; /* Nothing to do for this case but compilers like to complain */
@@ -3338,6 +4019,11 @@ void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, i
     if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER || layer.exact.tileLayer.tilesLength == 0)
         return;
 
+    if (layer.exact.tileLayer.chunks != NULL) { /* If the layer's static tiles were pre-rendered */
+        DrawTMXTileLayerChunks(map, screenRect, &layer.exact.tileLayer, posX, posY, tint);
+        return;
+    }
+
     /* Iterate through each tile that the screen rectangle overlaps with */
     uint32_t rawGid;
     Rectangle tileRect;
@@ -3348,45 +4034,243 @@ void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, i
     }
 }
 
-void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool flipX, bool flipY, bool flipDiag,
+void DrawTMXTileLayerChunks(const TmxMap* map, Rectangle screenRect, const TmxTileLayer* layer, int posX, int posY,
         Color tint) {
-    if (texture.id == 0) /* If the texture is invalid */
+    const RaytmxTileChunks* chunks = (const RaytmxTileChunks*)layer->chunks;
+    if (tint.a == 0)
         return;
 
-    float textureWidth = (float)texture.width;
-    float textureHeight = (float)texture.height;
+    /* Determine the range of chunks the screen rectangle overlaps with, in chunks rather than tiles or pixels */
+    float chunkWidth = (float)(RAYTMX_BAKE_CHUNK * map->tileWidth);
+    float chunkHeight = (float)(RAYTMX_BAKE_CHUNK * map->tileHeight);
+    int fromX = Clampi((int)floorf((screenRect.x - (float)posX) / chunkWidth), 0, (int)chunks->columns - 1);
+    int fromY = Clampi((int)floorf((screenRect.y - (float)posY) / chunkHeight), 0, (int)chunks->rows - 1);
+    int toX = Clampi((int)floorf((screenRect.x + screenRect.width - (float)posX) / chunkWidth), 0,
+        (int)chunks->columns - 1);
+    int toY = Clampi((int)floorf((screenRect.y + screenRect.height - (float)posY) / chunkHeight), 0,
+        (int)chunks->rows - 1);
+
+    for (int y = fromY; y <= toY; y++) {
+        for (int x = fromX; x <= toX; x++) {
+            const RaytmxTileChunk* chunk = &chunks->chunks[y * (int)chunks->columns + x];
+            if (chunk->renderTexture.id != 0) { /* If the chunk has static tiles */
+                Texture2D texture = chunk->renderTexture.texture;
+                Rectangle destRect;
+                destRect.x = (float)posX + (float)x * chunkWidth;
+                destRect.y = (float)posY + (float)y * chunkHeight;
+                destRect.width = (float)texture.width;
+                destRect.height = (float)texture.height;
+                /* Render textures are upside down, as far as raylib is concerned, so the source is flipped back */
+                Rectangle sourceRect;
+                sourceRect.x = 0.0f;
+                sourceRect.y = 0.0f;
+                sourceRect.width = (float)texture.width;
+                sourceRect.height = -(float)texture.height;
+                Vector2 origin; /* Reference point used for rotations, of which there are none */
+                origin.x = origin.y = 0.0f;
+                if (CheckCollisionRecs(screenRect, destRect)) {
+                    DrawTexturePro(/* texture: */ texture, /* source: */ sourceRect, /* dest: */ destRect,
+                        /* origin: */ origin, /* rotation: */ 0.0f, /* tint: */ tint);
+                }
+            }
 
-    /* Determine the area within the texture to be drawn */
-    /* Note: The coordinates here are in the [0.0, 1.0] range where (0.0, 0.0) is the bottom-left corner of the */
-    /* texture, (1.0, 0.0) is the bottom-right, and (1.0, 1.0) is the top-right. In other words, the coordinates are */
-    /* a ratio of the dimensions making (0.5, 0.5) the center of the texture regardless of its aspect ratio. */
-    Vector2 sourceTopLeft, sourceTopRight, sourceBottomLeft, sourceBottomRight;
-    sourceTopLeft.x = source.x / textureWidth;
-    sourceTopLeft.y = source.y / textureHeight;
-    sourceTopRight.x = (source.x + source.width) / textureWidth;
-    sourceTopRight.y = source.y / textureHeight;
-    sourceBottomLeft.x = source.x / textureWidth;
-    sourceBottomLeft.y = (source.y + source.height) / textureHeight;
-    sourceBottomRight.x = (source.x + source.width) / textureWidth;
-    sourceBottomRight.y = (source.y + source.height) / textureHeight;
-    if (flipDiag) { /* If the tile uses a diagonal flip */
-        /* "The diagonal flip should flip the bottom left and top right corners of the tile..." */
-        Vector2 temp = sourceBottomLeft;
-        sourceBottomLeft = sourceTopRight;
-        sourceTopRight = temp;
+            /* Animated tiles weren't pre-rendered so they're drawn on top, tile by tile, with their current frame */
+            for (uint32_t i = 0; i < chunk->animatedTilesLength; i++) {
+                uint32_t index = chunks->animatedTiles[chunk->animatedTilesOffset + i];
+                DrawTMXLayerTile(/* map: */ map, /* screenRect: */ screenRect, /* rawGid: */ layer->tiles[index],
+                    /* posX: */ posX + (int)((index % map->width) * map->tileWidth),
+                    /* posY: */ posY + (int)((index / map->width) * map->tileHeight), /* tint: */ tint);
+            }
+        }
     }
+}
+
+void BakeTMXTileLayers(const TmxMap* map, TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_TILE_LAYER && layers[i].exact.tileLayer.chunks == NULL)
+            layers[i].exact.tileLayer.chunks = BakeTMXTileLayer(map, &layers[i].exact.tileLayer);
+        else if (layers[i].type == LAYER_TYPE_GROUP)
+            BakeTMXTileLayers(map, layers[i].layers, layers[i].layersLength);
+    }
+}
+
+/**
+ * Pre-render the static tiles of a tile layer into render textures of RAYTMX_BAKE_CHUNK by RAYTMX_BAKE_CHUNK tiles so
+ * drawing the layer takes one texture per chunk on screen rather than one per tile. Animated tiles are left out of the
+ * render textures, and listed by chunk instead, so they can still be drawn with their current frames. Chunks with no
+ * static tiles get no render texture. This must be done on the thread that created the window.
+ *
+ * @param map A loaded map model, with its textures, containing the given tile layer.
+ * @param layer The tile layer within the given map to be baked.
+ * @return The layer's chunks, or NULL if the layer can't be baked (e.g. it has tiles larger than their cells).
+ */
+RaytmxTileChunks* BakeTMXTileLayer(const TmxMap* map, const TmxTileLayer* layer) {
+    if (map->width == 0 || map->height == 0 || map->tileWidth == 0 || map->tileHeight == 0 || layer->tiles == NULL ||
+            layer->tilesLength == 0)
+        return NULL;
+
+    /* Tiles are only baked if every one of them, and every frame of the animated ones, fits its cell exactly. Parts */
+    /* of larger or offset tiles would be cut off at the edges of chunks and drawn in a different order otherwise. */
+    uint32_t animatedTilesLength = 0;
+    for (uint32_t i = 0; i < layer->tilesLength; i++) {
+        uint32_t gid = GetGid(layer->tiles[i], NULL, NULL, NULL, NULL);
+        if (gid == 0 || gid >= map->gidsToTilesLength || map->gidsToTiles[gid].gid == 0) /* If nothing's drawn */
+            continue;
+        const TmxTile* tile = &map->gidsToTiles[gid];
+        if (tile->hasAnimation) {
+            for (uint32_t j = 0; j < tile->animation.framesLength; j++) {
+                if (!IsTileBakeable(map, tile->gid + tile->animation.frames[j].id))
+                    return NULL;
+            }
+            animatedTilesLength++;
+        } else if (!IsTileBakeable(map, gid))
+            return NULL;
+    }
+
+    uint32_t columns = (map->width + RAYTMX_BAKE_CHUNK - 1) / RAYTMX_BAKE_CHUNK;
+    uint32_t rows = (map->height + RAYTMX_BAKE_CHUNK - 1) / RAYTMX_BAKE_CHUNK;
+    RaytmxTileChunks* chunks = (RaytmxTileChunks*)MemAllocZero((unsigned int)(sizeof(RaytmxTileChunks) +
+        sizeof(RaytmxTileChunk) * columns * rows + sizeof(uint32_t) * animatedTilesLength));
+    chunks->chunks = (RaytmxTileChunk*)(chunks + 1); /* The arrays are allocated along with the struct */
+    chunks->animatedTiles = (uint32_t*)(chunks->chunks + columns * rows);
+    chunks->columns = columns;
+    chunks->rows = rows;
+
+    uint32_t animatedTilesOffset = 0;
+    for (uint32_t chunkY = 0; chunkY < rows; chunkY++) {
+        for (uint32_t chunkX = 0; chunkX < columns; chunkX++) {
+            RaytmxTileChunk* chunk = &chunks->chunks[chunkY * columns + chunkX];
+            uint32_t fromX = chunkX * RAYTMX_BAKE_CHUNK, fromY = chunkY * RAYTMX_BAKE_CHUNK;
+            uint32_t toX = fromX + RAYTMX_BAKE_CHUNK < map->width ? fromX + RAYTMX_BAKE_CHUNK : map->width;
+            uint32_t toY = fromY + RAYTMX_BAKE_CHUNK < map->height ? fromY + RAYTMX_BAKE_CHUNK : map->height;
+
+            /* Sort the chunk's tiles into animated ones, listed to be drawn every frame, and static ones */
+            bool hasStaticTiles = false;
+            chunk->animatedTilesOffset = animatedTilesOffset;
+            for (uint32_t y = fromY; y < toY; y++) {
+                for (uint32_t x = fromX; x < toX; x++) {
+                    uint32_t index = y * map->width + x;
+                    uint32_t gid = index < layer->tilesLength ? GetGid(layer->tiles[index], NULL, NULL, NULL, NULL) : 0;
+                    if (gid == 0 || gid >= map->gidsToTilesLength || map->gidsToTiles[gid].gid == 0)
+                        continue;
+                    if (map->gidsToTiles[gid].hasAnimation)
+                        chunks->animatedTiles[animatedTilesOffset++] = index;
+                    else
+                        hasStaticTiles = true;
+                }
+            }
+            chunk->animatedTilesLength = animatedTilesOffset - chunk->animatedTilesOffset;
+            if (!hasStaticTiles)
+                continue;
+
+            Rectangle chunkRect;
+            chunkRect.x = 0.0f;
+            chunkRect.y = 0.0f;
+            chunkRect.width = (float)((toX - fromX) * map->tileWidth);
+            chunkRect.height = (float)((toY - fromY) * map->tileHeight);
+            chunk->renderTexture = LoadRenderTexture((int)chunkRect.width, (int)chunkRect.height);
+            if (chunk->renderTexture.id == 0) { /* If the render texture couldn't be created, draw tile by tile */
+                TraceLog(LOG_WARNING, "RAYTMX: Unable to create a render texture to pre-render a tile layer with");
+                TmxLayer layers[1];
+                memset(layers, 0, sizeof(TmxLayer));
+                layers[0].type = LAYER_TYPE_TILE_LAYER;
+                layers[0].exact.tileLayer.chunks = chunks;
+                UnloadTMXTileLayerChunks(layers, 1);
+                return NULL;
+            }
+
+            /* Tiles are copied into the render texture as they are, alpha included, rather than blended with it. */
+            /* Drawing the chunk then blends its tiles with whatever's underneath exactly like drawing them would. */
+            BeginTextureMode(chunk->renderTexture);
+            ClearBackground(BLANK);
+            rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+            BeginBlendMode(BLEND_CUSTOM);
+            for (uint32_t y = fromY; y < toY; y++) {
+                for (uint32_t x = fromX; x < toX; x++) {
+                    uint32_t index = y * map->width + x;
+                    if (index >= layer->tilesLength)
+                        continue;
+                    uint32_t gid = GetGid(layer->tiles[index], NULL, NULL, NULL, NULL);
+                    if (gid < map->gidsToTilesLength && !map->gidsToTiles[gid].hasAnimation) {
+                        DrawTMXLayerTile(/* map: */ map, /* screenRect: */ chunkRect, /* rawGid: */ layer->tiles[index],
+                            /* posX: */ (int)((x - fromX) * map->tileWidth),
+                            /* posY: */ (int)((y - fromY) * map->tileHeight), /* tint: */ WHITE);
+                    }
+                }
+            }
+            EndBlendMode();
+            EndTextureMode();
+        }
+    }
+
+    return chunks;
+}
+
+/* Check whether a tile, by its GID, is drawn exactly within its cell so it can be pre-rendered into a chunk */
+bool IsTileBakeable(const TmxMap* map, uint32_t gid) {
+    if (gid >= map->gidsToTilesLength)
+        return true; /* Unknown GIDs aren't drawn at all */
+    const TmxTile* tile = &map->gidsToTiles[gid];
+    if (tile->gid == 0)
+        return true;
+    return !tile->hasAnimation && tile->offset.x == 0.0f && tile->offset.y == 0.0f &&
+        tile->sourceRect.width == (float)map->tileWidth && tile->sourceRect.height == (float)map->tileHeight;
+}
+
+void UnloadTMXTileLayerChunks(TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; layers != NULL && i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_TILE_LAYER && layers[i].exact.tileLayer.chunks != NULL) {
+            RaytmxTileChunks* chunks = (RaytmxTileChunks*)layers[i].exact.tileLayer.chunks;
+            for (uint32_t j = 0; j < chunks->columns * chunks->rows; j++) {
+                if (chunks->chunks[j].renderTexture.id != 0)
+                    UnloadRenderTexture(chunks->chunks[j].renderTexture);
+            }
+            MemFree(chunks); /* Also frees the arrays, which were allocated along with it */
+            layers[i].exact.tileLayer.chunks = NULL;
+        } else if (layers[i].type == LAYER_TYPE_GROUP)
+            UnloadTMXTileLayerChunks(layers[i].layers, layers[i].layersLength);
+    }
+}
+
+void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool flipX, bool flipY, bool flipDiag,
+        Color tint) {
+    if (texture.id == 0) /* If the texture is invalid */
+        return;
+
+    float textureWidth = (float)texture.width;
+    float textureHeight = (float)texture.height;
+
+    /* Determine the area within the texture to be drawn */
+    /* Note: The coordinates here are in the [0.0, 1.0] range where (0.0, 0.0) is the bottom-left corner of the */
+    /* texture, (1.0, 0.0) is the bottom-right, and (1.0, 1.0) is the top-right. In other words, the coordinates are */
+    /* a ratio of the dimensions making (0.5, 0.5) the center of the texture regardless of its aspect ratio. */
+    Vector2 sourceTopLeft, sourceTopRight, sourceBottomLeft, sourceBottomRight;
+    sourceTopLeft.x = source.x / textureWidth;
+    sourceTopLeft.y = source.y / textureHeight;
+    sourceTopRight.x = (source.x + source.width) / textureWidth;
+    sourceTopRight.y = source.y / textureHeight;
+    sourceBottomLeft.x = source.x / textureWidth;
+    sourceBottomLeft.y = (source.y + source.height) / textureHeight;
+    sourceBottomRight.x = (source.x + source.width) / textureWidth;
+    sourceBottomRight.y = (source.y + source.height) / textureHeight;
+    if (flipDiag) { /* If the tile uses a diagonal flip */
+        /* "The diagonal flip should flip the bottom left and top right corners of the tile..." */
+        Vector2 temp = sourceBottomLeft;
+        sourceBottomLeft = sourceTopRight;
+        sourceTopRight = temp;
+    }
+
+    /* Determine the area on the screen to be drawn to */
+    Vector2 destTopLeft, destTopRight, destBottomLeft, destBottomRight;
+    destTopLeft.x = dest.x;
+    destTopLeft.y = dest.y;
+    destTopRight.x = dest.x + dest.width;
+    destTopRight.y = dest.y;
+    destBottomLeft.x = dest.x;
+    destBottomLeft.y = dest.y + dest.height;
+    destBottomRight.x = dest.x + dest.width;
+    destBottomRight.y = dest.y + dest.height;
 
-    /* Determine the area on the screen to be drawn to */
-    Vector2 destTopLeft, destTopRight, destBottomLeft, destBottomRight;
-    destTopLeft.x = dest.x;
-    destTopLeft.y = dest.y;
-    destTopRight.x = dest.x + dest.width;
-    destTopRight.y = dest.y;
-    destBottomLeft.x = dest.x;
-    destBottomLeft.y = dest.y + dest.height;
-    destBottomRight.x = dest.x + dest.width;
-    destBottomRight.y = dest.y + dest.height;
-
     rlSetTexture(texture.id);
     rlBegin(RL_QUADS);
     {
@@ -4318,7 +5202,7 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces) {
 }
 
 TmxProperty* AddProperty(RaytmxState* raytmxState) {
-    RaytmxPropertyNode* node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+    RaytmxPropertyNode* node = (RaytmxPropertyNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxPropertyNode));
 
     if (raytmxState->propertiesRoot == NULL)
         raytmxState->propertiesRoot = node;
@@ -4331,19 +5215,514 @@ TmxProperty* AddProperty(RaytmxState* raytmxState) {
 }
 
 void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid) {
-    RaytmxTileLayerTileNode* node = (RaytmxTileLayerTileNode*)MemAllocZero(sizeof(RaytmxTileLayerTileNode));
-    node->gid = gid;
+    if (raytmxState->layerTiles == NULL) /* If not within a <layer>'s <data> or its tiles are being dropped */
+        return;
 
-    if (raytmxState->layerTilesRoot == NULL)
-        raytmxState->layerTilesRoot = node;
-    else
-        raytmxState->layerTilesTail->next = node;
-    raytmxState->layerTilesTail = node;
-    raytmxState->layerTilesLength += 1;
+    if (raytmxState->layerTilesLength < raytmxState->layerTilesCapacity)
+        raytmxState->layerTiles[raytmxState->layerTilesLength] = gid;
+    raytmxState->layerTilesLength += 1; /* Counted even when dropped so the mismatch can be reported */
+}
+
+void AddTileLayerTiles(RaytmxState* raytmxState, const void* gids, uint32_t gidsLength) {
+    if (raytmxState->layerTiles == NULL) /* If not within a <layer>'s <data> or its tiles are being dropped */
+        return;
+
+    /* 'gids' may be a byte buffer with no particular alignment so it's copied rather than read as uint32_t */
+    if (raytmxState->layerTilesLength < raytmxState->layerTilesCapacity) {
+        uint32_t copyLength = raytmxState->layerTilesCapacity - raytmxState->layerTilesLength;
+        if (copyLength > gidsLength)
+            copyLength = gidsLength;
+        memcpy(raytmxState->layerTiles + raytmxState->layerTilesLength, gids, sizeof(uint32_t) * copyLength);
+    }
+    raytmxState->layerTilesLength += gidsLength;
+}
+
+/* Parse GIDs out of CSV tile data one character at a time. GIDs are unsigned so any run of digits is a value and */
+/* anything else (commas, line breaks, spaces) separates them. Returns the number of characters consumed, always */
+/* 'length'. */
+size_t ParseCSVTilesScalar(RaytmxState* raytmxState, const char* csv, size_t length) {
+    uint32_t gid = 0;
+    bool isInValue = false;
+    for (size_t i = 0; i < length; i++) {
+        uint32_t digit = (uint32_t)(unsigned char)csv[i] - '0';
+        if (digit < 10) {
+            gid = gid * 10 + digit;
+            isInValue = true;
+        } else if (isInValue) { /* If this separator ends a value */
+            AddTileLayerTile(raytmxState, gid);
+            gid = 0;
+            isInValue = false;
+        }
+    }
+    if (isInValue) /* If the data didn't end with a separator */
+        AddTileLayerTile(raytmxState, gid);
+    return length;
+}
+
+#ifdef RAYTMX_CSV_SIMD
+/* Bit N of the result is set when csv[N] is a digit */
+static inline uint64_t GetCSVDigitMask(const char* csv) {
+    uint64_t mask = 0;
+#ifdef RAYTMX_CSV_AVX2
+    const __m256i belowZero = _mm256_set1_epi8('0' - 1), aboveNine = _mm256_set1_epi8('9' + 1);
+    for (int i = 0; i < RAYTMX_CSV_CHUNK; i += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(csv + i));
+        /* Signed comparisons are fine: bytes >= 0x80 are negative and never between '0' and '9' */
+        __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, belowZero), _mm256_cmpgt_epi8(aboveNine, bytes));
+        mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(isDigit) << i;
+    }
+#else /* RAYTMX_CSV_SSE2 */
+    const __m128i belowZero = _mm_set1_epi8('0' - 1), aboveNine = _mm_set1_epi8('9' + 1);
+    for (int i = 0; i < RAYTMX_CSV_CHUNK; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(csv + i));
+        /* Signed comparisons are fine: bytes >= 0x80 are negative and never between '0' and '9' */
+        __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(bytes, belowZero), _mm_cmplt_epi8(bytes, aboveNine));
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(isDigit) << i;
+    }
+#endif
+    return mask;
+}
+
+static inline uint32_t CountTrailingZeros64(uint64_t value) { /* 'value' must not be zero */
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctzll(value);
+#endif
+}
+
+/* Convert 1-8 ASCII digits at once. The eight bytes at 'digits' must be readable, even past 'length'. */
+static inline uint32_t ParseEightDigits(const char* digits, uint32_t length) {
+    uint64_t value;
+    memcpy(&value, digits, sizeof(value));
+    /* x86 is little-endian so the first digit is the lowest byte. Shifting left drops whatever follows the digits */
+    /* and leaves zero bytes, which act as leading zeroes, in front of them. */
+    value <<= 8 * (8 - length);
+    /* Combine neighbouring digits, then pairs, then quads, the standard SWAR (SIMD within a register) reduction */
+    value = ((value & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    value = ((value & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return (uint32_t)(((value & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+}
+#endif /* RAYTMX_CSV_SIMD */
+
+/* Parse GIDs out of CSV tile data. With SIMD available, 64 characters at a time are classified into a bit mask of */
+/* digits whose runs are then converted in bulk. The tail, and everything on other platforms, is parsed by */
+/* ParseCSVTilesScalar(), with identical results. */
+void ParseCSVTiles(RaytmxState* raytmxState, const char* csv, size_t length) {
+    size_t i = 0;
+#ifdef RAYTMX_CSV_SIMD
+    size_t valueEnd = 0; /* Index just past the last value parsed, which may reach into the next chunk */
+    /* Leave at least eight characters past every chunk so ParseEightDigits() never reads out of bounds */
+    while (tmxDecodeSIMD && i + RAYTMX_CSV_CHUNK + 8 <= length) {
+        uint64_t digits = GetCSVDigitMask(csv + i);
+        if (valueEnd > i) /* Drop the digits of a value that started in the previous chunk */
+            digits &= valueEnd - i >= RAYTMX_CSV_CHUNK ? 0 : ~0ULL << (valueEnd - i);
+        uint64_t starts = digits & ~(digits << 1); /* Digits not preceded by a digit */
+        while (starts != 0) {
+            uint32_t start = CountTrailingZeros64(starts);
+            starts &= starts - 1;
+            /* The run ends at the first non-digit, or the end of the chunk when every bit from 'start' up is set */
+            uint64_t nonDigits = ~(digits >> start);
+            uint32_t runLength = nonDigits == 0 ? RAYTMX_CSV_CHUNK - start : CountTrailingZeros64(nonDigits);
+            size_t valueStart = i + start;
+            if (start + runLength == RAYTMX_CSV_CHUNK) { /* If the run might continue into the next chunk */
+                while (valueStart + runLength < length && (uint32_t)(unsigned char)csv[valueStart + runLength] -
+                        '0' < 10)
+                    runLength += 1;
+            }
+            uint32_t gid;
+            if (runLength <= 8 && valueStart + 8 <= length)
+                gid = ParseEightDigits(csv + valueStart, runLength);
+            else { /* Nine or more digits, i.e. GIDs with flip flags set */
+                gid = 0;
+                for (uint32_t j = 0; j < runLength; j++)
+                    gid = gid * 10 + (uint32_t)(csv[valueStart + j] - '0');
+            }
+            AddTileLayerTile(raytmxState, gid);
+            valueEnd = valueStart + runLength;
+        }
+        i += RAYTMX_CSV_CHUNK;
+    }
+    /* Runs touching a chunk's end were followed to their actual end, so no value straddles 'i' unless it's this one */
+    if (valueEnd > i)
+        i = valueEnd;
+#endif /* RAYTMX_CSV_SIMD */
+    ParseCSVTilesScalar(raytmxState, csv + i, length - i);
+}
+
+/* Maps each byte to its Base64 value (0-63) or one of RAYTMX_BASE64_INVALID, _SPACE, or _PADDING */
+static const uint8_t raytmxBase64Table[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+/* Decode Base64 one character at a time into 'output', writing at most 'outputCapacity' bytes. Whitespace anywhere */
+/* is skipped and padding ('=') ends the data. The full decoded length is stored in 'outputLength' even when bytes */
+/* past the capacity had to be dropped. Returns false if an invalid character was found where decoding stopped. */
+bool DecodeBase64Scalar(const char* encoded, size_t length, unsigned char* output, size_t outputCapacity,
+        size_t* outputLength) {
+    size_t o = 0;
+    uint32_t group = 0, groupLength = 0; /* Bits of the current group of four characters and how many were read */
+    bool isValid = true;
+    for (size_t i = 0; i < length; i++) {
+        /* Fast path: between groups, decode groups of four characters for as long as they're all Base64 digits. */
+        /* Each group's three bytes are stored as one four-byte word, so there has to be room for the extra byte, */
+        /* which is zero and overwritten by whatever is decoded next. */
+        if (groupLength == 0 && o + 4 <= outputCapacity) {
+            size_t groups = (length - i) / 4, groupsFitting = (outputCapacity - o - 1) / 3;
+            for (groups = groups < groupsFitting ? groups : groupsFitting; groups > 0; groups--) {
+                uint32_t a = raytmxBase64Table[(unsigned char)encoded[i]];
+                uint32_t b = raytmxBase64Table[(unsigned char)encoded[i + 1]];
+                uint32_t c = raytmxBase64Table[(unsigned char)encoded[i + 2]];
+                uint32_t d = raytmxBase64Table[(unsigned char)encoded[i + 3]];
+                if ((a | b | c | d) >= 64)
+                    break;
+                uint32_t bits = (a << 26) | (b << 20) | (c << 14) | (d << 8);
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                bits = __builtin_bswap32(bits);
+#elif !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__
+                bits = (bits >> 24) | ((bits >> 8) & 0xFF00) | ((bits << 8) & 0xFF0000) | (bits << 24);
+#endif
+                memcpy(output + o, &bits, 4);
+                o += 3;
+                i += 4;
+            }
+            if (i >= length)
+                break;
+        }
+        uint8_t value = raytmxBase64Table[(unsigned char)encoded[i]];
+        if (value < 64) {
+            group = (group << 6) | value;
+            if (++groupLength == 4) { /* Four characters make three bytes */
+                unsigned char bytes[3] = { (unsigned char)(group >> 16), (unsigned char)(group >> 8),
+                    (unsigned char)group };
+                if (o + 3 <= outputCapacity)
+                    memcpy(output + o, bytes, 3);
+                else {
+                    for (uint32_t j = 0; j < 3; j++) {
+                        if (o + j < outputCapacity)
+                            output[o + j] = bytes[j];
+                    }
+                }
+                o += 3;
+                group = 0;
+                groupLength = 0;
+            }
+        } else if (value == RAYTMX_BASE64_PADDING)
+            break;
+        else if (value == RAYTMX_BASE64_INVALID) {
+            isValid = false;
+            break;
+        }
+    }
+    /* A final group of two or three characters (normally followed by padding) makes one or two bytes */
+    if (groupLength >= 2) {
+        group <<= 6 * (4 - groupLength);
+        for (uint32_t j = 0; j < groupLength - 1; j++, o++) {
+            if (o < outputCapacity)
+                output[o] = (unsigned char)(group >> (16 - 8 * j));
+        }
+    }
+
+    *outputLength = o;
+    return isValid;
+}
+
+/* Characters are translated by their nibbles with byte shuffles, then packed from 6 to 8 bits with multiply-adds. */
+/* Each kernel decodes whole blocks of characters from the start of 'encoded' until one contains anything other than */
+/* the 64 Base64 digits (whitespace, padding, or an invalid character) or the next block's bytes wouldn't fit. Every */
+/* block stores as many bytes as it has characters, zeroes after the three quarters it decodes. Returns the number */
+/* of characters decoded, storing the number of bytes to 'outputLength', so the scalar decoder can take over. */
+#ifdef RAYTMX_BASE64_AVX2
+RAYTMX_TARGET_AVX2 static size_t DecodeBase64BlocksAVX2(const char* encoded, size_t length, unsigned char* output,
+        size_t outputCapacity, size_t* outputLength) {
+    const __m256i lowNibbleBits = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i highNibbleBits = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i offsets = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i packOrder = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0, o = 0;
+    for (; i + RAYTMX_BASE64_AVX2_BLOCK <= length && o + RAYTMX_BASE64_AVX2_BLOCK <= outputCapacity;
+            i += RAYTMX_BASE64_AVX2_BLOCK, o += RAYTMX_BASE64_AVX2_BLOCK / 4 * 3) {
+        __m256i characters = _mm256_loadu_si256((const __m256i*)(encoded + i));
+        __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(characters, 4), _mm256_set1_epi8(0x0F));
+        __m256i lowNibbles = _mm256_and_si256(characters, _mm256_set1_epi8(0x0F));
+        /* Every character outside A-Z, a-z, 0-9, '+', and '/' has a bit in common between its two nibble lookups */
+        if (!_mm256_testz_si256(_mm256_shuffle_epi8(lowNibbleBits, lowNibbles),
+                _mm256_shuffle_epi8(highNibbleBits, highNibbles)))
+            break;
+        /* The high nibble picks the offset from ASCII to value for each range, but '/' shares one with '+' */
+        __m256i isSlash = _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('/'));
+        __m256i values = _mm256_add_epi8(characters,
+            _mm256_shuffle_epi8(offsets, _mm256_add_epi8(isSlash, highNibbles)));
+        /* Merge pairs of 6-bit values into 12 bits, then pairs of those into 24, and gather the three bytes of each */
+        __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        merged = _mm256_shuffle_epi8(merged, packOrder);
+        /* Each 128-bit lane now holds 12 bytes, move them next to each other */
+        merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i*)(output + o), merged);
+    }
+    *outputLength = o;
+    return i;
+}
+#endif /* RAYTMX_BASE64_AVX2 */
+
+#ifdef RAYTMX_BASE64_SSE41
+RAYTMX_TARGET_SSE41 static size_t DecodeBase64BlocksSSE41(const char* encoded, size_t length, unsigned char* output,
+        size_t outputCapacity, size_t* outputLength) {
+    const __m128i lowNibbleBits = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i highNibbleBits = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i packOrder = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0, o = 0;
+    for (; i + RAYTMX_BASE64_SSE41_BLOCK <= length && o + RAYTMX_BASE64_SSE41_BLOCK <= outputCapacity;
+            i += RAYTMX_BASE64_SSE41_BLOCK, o += RAYTMX_BASE64_SSE41_BLOCK / 4 * 3) {
+        __m128i characters = _mm_loadu_si128((const __m128i*)(encoded + i));
+        __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(characters, 4), _mm_set1_epi8(0x0F));
+        __m128i lowNibbles = _mm_and_si128(characters, _mm_set1_epi8(0x0F));
+        /* Every character outside A-Z, a-z, 0-9, '+', and '/' has a bit in common between its two nibble lookups */
+        if (!_mm_testz_si128(_mm_shuffle_epi8(lowNibbleBits, lowNibbles),
+                _mm_shuffle_epi8(highNibbleBits, highNibbles)))
+            break;
+        /* The high nibble picks the offset from ASCII to value for each range, but '/' shares one with '+' */
+        __m128i isSlash = _mm_cmpeq_epi8(characters, _mm_set1_epi8('/'));
+        __m128i values = _mm_add_epi8(characters, _mm_shuffle_epi8(offsets, _mm_add_epi8(isSlash, highNibbles)));
+        /* Merge pairs of 6-bit values into 12 bits, then pairs of those into 24, and gather the three bytes of each */
+        __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i*)(output + o), _mm_shuffle_epi8(merged, packOrder));
+    }
+    *outputLength = o;
+    return i;
+}
+#endif /* RAYTMX_BASE64_SSE41 */
+
+/* Decode Base64 into 'output' with the same results as DecodeBase64Scalar(). With SIMD available, whole blocks of */
+/* characters are decoded at once until one contains something other than Base64 digits, typically the trailing */
+/* whitespace and padding, and the scalar decoder finishes from there. */
+bool DecodeBase64(const char* encoded, size_t length, unsigned char* output, size_t outputCapacity,
+        size_t* outputLength) {
+    size_t i = 0, o = 0;
+#ifdef RAYTMX_BASE64_SIMD
+    /* XML content normally starts with a line break and indentation before the data itself */
+    while (i < length && raytmxBase64Table[(unsigned char)encoded[i]] == RAYTMX_BASE64_SPACE)
+        i++;
+    if (tmxDecodeSIMD) {
+#ifdef RAYTMX_BASE64_DISPATCH
+        if (__builtin_cpu_supports("avx2"))
+            i += DecodeBase64BlocksAVX2(encoded + i, length - i, output, outputCapacity, &o);
+        else if (__builtin_cpu_supports("sse4.1"))
+            i += DecodeBase64BlocksSSE41(encoded + i, length - i, output, outputCapacity, &o);
+#elif defined(RAYTMX_BASE64_AVX2)
+        i += DecodeBase64BlocksAVX2(encoded + i, length - i, output, outputCapacity, &o);
+#else
+        i += DecodeBase64BlocksSSE41(encoded + i, length - i, output, outputCapacity, &o);
+#endif
+    }
+#endif /* RAYTMX_BASE64_SIMD */
+    size_t tailLength;
+    bool isValid = DecodeBase64Scalar(encoded + i, length - i, output + o, outputCapacity > o ? outputCapacity - o : 0,
+        &tailLength);
+    *outputLength = o + tailLength;
+    return isValid;
+}
+
+/* Decode a chunk of a tile layer's <data> content. A GID or group of four Base64 characters can be split between */
+/* two chunks so the end of an unfinished one is held back until the next chunk, or the last ('isFinal'), follows. */
+void ParseDataContent(RaytmxState* raytmxState, const char* content, size_t length, bool isFinal) {
+    bool isBase64 = strcmp(raytmxState->tileLayer->encoding, "base64") == 0;
+    if (!isBase64 && strcmp(raytmxState->tileLayer->encoding, "csv") != 0)
+        return;
+
+    size_t start = 0;
+    if (raytmxState->dataCarryLength > 0) { /* If the previous chunk ended partway through something */
+        /* Finish it with the beginning of this chunk */
+        bool isComplete;
+        if (isBase64) {
+            /* Whitespace between the characters is skipped while padding, or anything else, ends the group early */
+            for (; start < length && raytmxState->dataCarryLength < 4; start++) {
+                uint8_t value = raytmxBase64Table[(unsigned char)content[start]];
+                if (value < 64)
+                    raytmxState->dataCarry[raytmxState->dataCarryLength++] = content[start];
+                else if (value != RAYTMX_BASE64_SPACE)
+                    break;
+            }
+            isComplete = raytmxState->dataCarryLength == 4 || start < length;
+        } else {
+            while (start < length && (uint32_t)(unsigned char)content[start] - '0' < 10 &&
+                    raytmxState->dataCarryLength < sizeof(raytmxState->dataCarry))
+                raytmxState->dataCarry[raytmxState->dataCarryLength++] = content[start++];
+            isComplete = start < length || raytmxState->dataCarryLength == sizeof(raytmxState->dataCarry);
+        }
+        if (!isComplete && !isFinal) /* If the whole chunk was needed and still wasn't enough */
+            return;
+        DecodeDataContent(raytmxState, raytmxState->dataCarry, raytmxState->dataCarryLength);
+        raytmxState->dataCarryLength = 0;
+    }
+
+    size_t end = length;
+    if (!isFinal) {
+        /* Find where the last complete GID, or group of four Base64 characters, ends */
+        if (isBase64) {
+            size_t digits = 0;
+            for (size_t i = start; i < length; i++)
+                digits += raytmxBase64Table[(unsigned char)content[i]] < 64;
+            for (size_t remainder = digits % 4; remainder > 0; ) {
+                end -= 1;
+                if (raytmxBase64Table[(unsigned char)content[end]] < 64)
+                    remainder -= 1;
+            }
+        } else {
+            while (end > start && (uint32_t)(unsigned char)content[end - 1] - '0' < 10)
+                end -= 1;
+        }
+        /* Hold back the rest, without whitespace. That's at most three Base64 characters but a run of digits could */
+        /* be longer than any GID, in which case it's left for ParseCSVTiles() to make what it can of it. So is an */
+        /* invalid Base64 character, which the decoder has to come across to know where to stop. */
+        bool isHeldBack = isBase64 || length - end <= sizeof(raytmxState->dataCarry);
+        for (size_t i = end; isBase64 && i < length; i++) {
+            if (raytmxBase64Table[(unsigned char)content[i]] == RAYTMX_BASE64_INVALID)
+                isHeldBack = false;
+        }
+        if (isHeldBack) {
+            for (size_t i = end; i < length; i++) {
+                if (!isBase64 || raytmxBase64Table[(unsigned char)content[i]] < 64)
+                    raytmxState->dataCarry[raytmxState->dataCarryLength++] = content[i];
+            }
+        } else
+            end = length;
+    }
+    DecodeDataContent(raytmxState, content + start, end - start);
+}
+
+/* Decode GIDs from complete CSV values or groups of Base64 characters of a tile layer's <data> content */
+void DecodeDataContent(RaytmxState* raytmxState, const char* content, size_t length) {
+    if (length == 0)
+        return;
+
+    if (strcmp(raytmxState->tileLayer->encoding, "csv") == 0) {
+        /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
+        /* "31,32,33" where 31, 32, and 33 are GIDs */
+        ParseCSVTiles(raytmxState, content, length);
+        return;
+    }
+
+    /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. XML considers */
+    /* everything between <data> and </data> to be content so there is probably some whitespace on both ends of it, */
+    /* which the decoder skips. */
+    if (raytmxState->isDataInvalid) /* If an earlier chunk had an invalid character, decoding stopped there */
+        return;
+    unsigned char* output;
+    size_t outputCapacity;
+    if (raytmxState->tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
+        /* Every four bytes are a single GID so decode straight into the layer's preallocated tiles */
+        uint32_t tilesStart = raytmxState->layerTilesLength < raytmxState->layerTilesCapacity ?
+            raytmxState->layerTilesLength : raytmxState->layerTilesCapacity;
+        size_t tilesBytes = sizeof(uint32_t) * (raytmxState->layerTilesCapacity - tilesStart);
+        size_t offset = raytmxState->dataDecodedLength < tilesBytes ? raytmxState->dataDecodedLength : tilesBytes;
+        output = (unsigned char*)(raytmxState->layerTiles + tilesStart) + offset;
+        outputCapacity = tilesBytes - offset;
+    } else { /* If the Base-64encoded data is also compressed, it's decompressed once all of it has been decoded */
+        /* Every four characters decode to at most three bytes */
+        size_t requiredCapacity = raytmxState->dataDecodedLength + length / 4 * 3 + 3;
+        if (requiredCapacity > raytmxState->dataDecodedCapacity) {
+            size_t newCapacity = raytmxState->dataDecodedCapacity * 2;
+            if (newCapacity < requiredCapacity)
+                newCapacity = requiredCapacity;
+            unsigned char* newDecoded = (unsigned char*)MemRealloc(raytmxState->dataDecoded,
+                (unsigned int)newCapacity);
+            if (newDecoded == NULL) {
+                raytmxState->isDataInvalid = true;
+                return;
+            }
+            raytmxState->dataDecoded = newDecoded;
+            raytmxState->dataDecodedCapacity = newCapacity;
+        }
+        output = raytmxState->dataDecoded + raytmxState->dataDecodedLength;
+        outputCapacity = raytmxState->dataDecodedCapacity - raytmxState->dataDecodedLength;
+    }
+    size_t decodedLength;
+    if (!DecodeBase64(content, length, output, outputCapacity, &decodedLength))
+        raytmxState->isDataInvalid = true;
+    raytmxState->dataDecodedLength += decodedLength;
+}
+
+#ifdef RAYTMX_SUPPORT_ZSTD
+/* Decompress a Zstandard stream of GIDs straight into the layer's tiles, as they're produced, with no intermediate */
+/* buffer. Anything past the layer's capacity is decompressed into scratch space and dropped but still counted so */
+/* the mismatch can be reported. Returns false if the stream is corrupt or truncated. */
+bool DecompressZstdTiles(RaytmxState* raytmxState, const void* compressed, size_t compressedLength) {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    if (context == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to create a Zstandard context for layer \"%s\"", raytmxState->layer->name);
+        return false;
+    }
+
+    uint32_t tilesStart = raytmxState->layerTilesLength < raytmxState->layerTilesCapacity ?
+        raytmxState->layerTilesLength : raytmxState->layerTilesCapacity;
+    unsigned char dropped[4096]; /* Receives decompressed bytes that don't fit in the layer */
+    ZSTD_inBuffer input = { compressed, compressedLength, 0 };
+    ZSTD_outBuffer output = { raytmxState->layerTiles + tilesStart,
+        sizeof(uint32_t) * (raytmxState->layerTilesCapacity - tilesStart), 0 };
+    size_t decompressedLength = 0;
+    bool isValid = true;
+    while (true) {
+        size_t result = ZSTD_decompressStream(context, &output, &input);
+        if (ZSTD_isError(result)) {
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to decompress Zstandard data for layer \"%s\": %s",
+                raytmxState->layer->name, ZSTD_getErrorName(result));
+            isValid = false;
+            break;
+        }
+        if (result == 0 && input.pos == input.size) /* If the last frame is complete and fully flushed */
+            break;
+        if (output.pos == output.size) { /* If the output is full, there may be more to flush */
+            decompressedLength += output.pos;
+            output.dst = dropped;
+            output.size = sizeof(dropped);
+            output.pos = 0;
+        } else if (input.pos == input.size) { /* If all input was consumed but the frame isn't complete */
+            TraceLog(LOG_ERROR, "RAYTMX: Zstandard data for layer \"%s\" is truncated", raytmxState->layer->name);
+            isValid = false;
+            break;
+        }
+    }
+    decompressedLength += output.pos;
+    ZSTD_freeDCtx(context);
+
+    raytmxState->layerTilesLength += (uint32_t)(decompressedLength / 4);
+    return isValid;
 }
+#endif /* RAYTMX_SUPPORT_ZSTD */
 
 TmxTileset* AddTileset(RaytmxState* raytmxState) {
-    RaytmxTilesetNode* node = (RaytmxTilesetNode*)MemAllocZero(sizeof(RaytmxTilesetNode));
+    RaytmxTilesetNode* node = (RaytmxTilesetNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxTilesetNode));
 
     if (raytmxState->tilesetsRoot == NULL)
         raytmxState->tilesetsRoot = node;
@@ -4356,7 +5735,7 @@ TmxTileset* AddTileset(RaytmxState* raytmxState) {
 }
 
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
-    RaytmxTilesetTileNode* node = (RaytmxTilesetTileNode*)MemAllocZero(sizeof(RaytmxTilesetTileNode));
+    RaytmxTilesetTileNode* node = (RaytmxTilesetTileNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxTilesetTileNode));
 
     if (raytmxState->tilesetTilesRoot == NULL)
         raytmxState->tilesetTilesRoot = node;
@@ -4369,7 +5748,8 @@ TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
 }
 
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
-    RaytmxAnimationFrameNode* node = (RaytmxAnimationFrameNode*)MemAllocZero(sizeof(RaytmxAnimationFrameNode));
+    RaytmxAnimationFrameNode* node =
+        (RaytmxAnimationFrameNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxAnimationFrameNode));
 
     if (raytmxState->animationFramesRoot == NULL)
         raytmxState->animationFramesRoot = node;
@@ -4382,7 +5762,7 @@ TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
 }
 
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
-    RaytmxLayerNode* node = (RaytmxLayerNode*)MemAllocZero(sizeof(RaytmxLayerNode));
+    RaytmxLayerNode* node = (RaytmxLayerNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxLayerNode));
     /* There are some non-zero default values for several layer attributes: */
     node->layer.opacity = 1.0;
     node->layer.visible = true;
@@ -4413,7 +5793,7 @@ TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
 }
 
 TmxObject* AddObject(RaytmxState* raytmxState) {
-    RaytmxObjectNode* node = (RaytmxObjectNode*)MemAllocZero(sizeof(RaytmxObjectNode));
+    RaytmxObjectNode* node = (RaytmxObjectNode*)ArenaAllocZero(raytmxState, sizeof(RaytmxObjectNode));
     /* <object> elements have one non-zero default value: */
     node->object.visible = true;
 
@@ -4468,9 +5848,14 @@ RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char*
         cachedTextureNode = cachedTextureNode->next;
     }
 
-    /* Try to load the texture */
+    /* With texture loading disabled or deferred, leave the image's texture zeroed */
+    if (!tmxLoadTextures || tmxDeferTextures)
+        return NULL;
+
+    /* Try to load the texture, from the image decoded by PrefetchTMX() if there is one */
     char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
-    Texture2D texture = LoadTexture(fullPath);
+    RaytmxPrefetchEntry* prefetched = FindPrefetchEntry(tmxPrefetch, PREFETCH_IMAGE, fullPath);
+    Texture2D texture = prefetched != NULL ? LoadTextureFromImage(prefetched->image) : LoadTexture(fullPath);
     if (texture.id == 0) { /* If loading the texture failed */
         TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", fullPath);
         return NULL;
@@ -4608,10 +5993,50 @@ void* MemAllocZero(unsigned int size) {
     return buffer;
 }
 
+void* ArenaAllocZero(RaytmxState* raytmxState, size_t size) {
+    /* Round up so the next allocation stays aligned as well */
+    size = (size + RAYTMX_ARENA_ALIGNMENT - 1) & ~((size_t)RAYTMX_ARENA_ALIGNMENT - 1);
+    const size_t headerSize = (sizeof(RaytmxArenaBlock) + RAYTMX_ARENA_ALIGNMENT - 1) &
+        ~((size_t)RAYTMX_ARENA_ALIGNMENT - 1);
+
+    RaytmxArenaBlock* block = raytmxState->arena;
+    if (block == NULL || block->used + size > block->capacity) { /* If a new block is needed */
+        size_t capacity = RAYTMX_ARENA_BLOCK_SIZE;
+        if (block != NULL && block->capacity < RAYTMX_ARENA_MAX_BLOCK_SIZE)
+            capacity = block->capacity * 2; /* Grow geometrically so large maps need few blocks */
+        else if (block != NULL)
+            capacity = block->capacity;
+        if (capacity < size) /* Just in case a single allocation is larger than a block */
+            capacity = size;
+        /* The block's memory is handed out zeroed piece by piece, so a plain allocation is enough here */
+        RaytmxArenaBlock* newBlock = (RaytmxArenaBlock*)MemAlloc((unsigned int)(headerSize + capacity));
+        newBlock->next = block;
+        newBlock->used = 0;
+        newBlock->capacity = capacity;
+        raytmxState->arena = block = newBlock;
+    }
+
+    void* memory = (unsigned char*)block + headerSize + block->used;
+    block->used += size;
+    memset(memory, 0, size); /* Initialize any values to zero, NULL, false, or an equivalent enum value */
+    return memory;
+}
+
+void FreeArena(RaytmxState* raytmxState) {
+    /* One free per block rather than per node. Blocks double in size so even huge maps only need a handful. */
+    RaytmxArenaBlock* block = raytmxState->arena;
+    while (block != NULL) {
+        RaytmxArenaBlock* next = block->next;
+        MemFree(block);
+        block = next;
+    }
+    raytmxState->arena = NULL;
+}
+
 /* "Get directory for a given filePath" */
 /* raylib's GetDirectoryPath() doesn't work as described so this is used in its place */
 char* GetDirectoryPath2(const char* filePath) {
-    static char directoryPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
+    static RAYTMX_THREAD_LOCAL char directoryPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
     memset(directoryPath, '\0', 260);
     size_t length = strlen(filePath);
     /* Paths beginning with a Windows drive letter (C:\, D:\, etc.) or beginning with a slash are absolute paths */
@@ -4636,7 +6061,7 @@ char* GetDirectoryPath2(const char* filePath) {
 }
 
 char* JoinPath(const char* prefix, const char* suffix) {
-    static char joinedPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
+    static RAYTMX_THREAD_LOCAL char joinedPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
     memset(joinedPath, '\0', 260);
     StringCopy(joinedPath, prefix);
     size_t prefixLength = strlen(prefix);
@@ -4685,6 +6110,1106 @@ void StringConcatenate(char* destination, const char* source) {
 #endif
 }
 
+/**
+ * Find and load every external resource a TMX document references before the document itself is parsed. The TMX
+ * document is scanned for the external tilesets (TSX files), object templates (TX files), and images it references,
+ * as are those tilesets and templates for their own images, and then all of them are parsed or decoded at once by
+ * RunTasks(). ParseDocument() picks them up through FindPrefetchEntry() as it comes across the same references and
+ * loads anything the scan missed itself, so the scan doesn't have to be a full XML parse.
+ *
+ * @param prefetch Zeroed prefetch to populate. It must be freed with FreePrefetch().
+ * @param fileName File name and/or path of the TMX document.
+ */
+void PrefetchTMX(RaytmxPrefetch* prefetch, const char* fileName) {
+    ScanPrefetchReferences(prefetch, fileName, 0);
+    RunTasks(RunPrefetchTask, prefetch->entries, prefetch->entriesLength);
+}
+
+/**
+ * Add the resources referenced by a document's <tileset source="">, <object template="">, and <image source="">
+ * tags. Tilesets and templates referenced by the TMX document get entries of their own and are scanned in turn. Any
+ * referenced by those are parsed along with them, on the same thread, so only their images are added.
+ *
+ * @param prefetch The prefetch to add entries to.
+ * @param fileName File name and/or path of the document to scan.
+ * @param depth Zero for the TMX document, one for the documents it references, and so on.
+ */
+void ScanPrefetchReferences(RaytmxPrefetch* prefetch, const char* fileName, int depth) {
+    static const struct {
+        const char* tag;
+        const char* attribute;
+        RaytmxPrefetchKind kind;
+    } references[] = {
+        { "tileset", "source", PREFETCH_TSX },
+        { "object", "template", PREFETCH_TX },
+        { "image", "source", PREFETCH_IMAGE }
+    };
+    bool loadImages = tmxLoadTextures && !tmxDeferTextures;
+
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL)
+        return; /* The parser will report the failure */
+    char documentDirectory[512];
+    StringCopy(documentDirectory, GetDirectoryPath2(fileName));
+
+    /* Like the parser, read the document a piece at a time. A tag cut off at the end of the window is moved to the */
+    /* front and finished by the next read. */
+    const size_t windowSize = 2 * RAYTMX_STREAM_CHUNK;
+    char* content = (char*)MemAlloc((unsigned int)windowSize + 1);
+    size_t contentLength = 0, readLength;
+    do {
+        readLength = fread(content + contentLength, 1, windowSize - contentLength, file);
+        contentLength += readLength;
+        content[contentLength] = '\0';
+        const char* unfinished = content + contentLength;
+        for (const char* tag = strchr(content, '<'); tag != NULL; tag = strchr(tag, '<')) {
+            tag += 1;
+            const char* tagEnd = strchr(tag, '>');
+            if (tagEnd == NULL) {
+                unfinished = tag - 1;
+                break;
+            }
+            for (size_t i = 0; i < sizeof(references) / sizeof(references[0]); i++) {
+                size_t tagLength = strlen(references[i].tag), attributeLength = strlen(references[i].attribute);
+                if (strncmp(tag, references[i].tag, tagLength) != 0 || !isspace((unsigned char)tag[tagLength]))
+                    continue;
+                /* Find the attribute within the tag, preceded by whitespace and followed by '=' and a quoted value */
+                for (const char* attribute = tag + tagLength; attribute < tagEnd; attribute++) {
+                    if (!isspace((unsigned char)*attribute) ||
+                            strncmp(attribute + 1, references[i].attribute, attributeLength) != 0 ||
+                            attribute[attributeLength + 1] != '=')
+                        continue;
+                    const char* value = attribute + attributeLength + 2;
+                    const char* valueEnd = (*value == '"' || *value == '\'') ? strchr(value + 1, *value) : NULL;
+                    value += 1;
+                    /* Values with entities (e.g. "&amp;") are left to the parser, which decodes them */
+                    if (valueEnd == NULL || valueEnd > tagEnd || valueEnd == value || valueEnd - value >= 260 ||
+                            memchr(value, '&', (size_t)(valueEnd - value)) != NULL)
+                        break;
+                    char path[260], fullPath[512];
+                    StringCopyN(path, value, (size_t)(valueEnd - value));
+                    path[valueEnd - value] = '\0';
+                    StringCopy(fullPath, JoinPath(documentDirectory, path));
+                    if (references[i].kind == PREFETCH_IMAGE) {
+                        if (loadImages)
+                            AddPrefetchEntry(prefetch, PREFETCH_IMAGE, fullPath);
+                    } else if (depth == 0) {
+                        if (AddPrefetchEntry(prefetch, references[i].kind, fullPath))
+                            ScanPrefetchReferences(prefetch, fullPath, depth + 1);
+                    } else if (references[i].kind == PREFETCH_TSX && depth == 1) /* e.g. a template's tileset */
+                        ScanPrefetchReferences(prefetch, fullPath, depth + 1);
+                    break;
+                }
+                break;
+            }
+            tag = tagEnd;
+        }
+        contentLength -= (size_t)(unfinished - content);
+        if (contentLength == windowSize) /* If a single tag doesn't fit, leave it to the parser */
+            contentLength = 0;
+        memmove(content, unfinished, contentLength);
+    } while (readLength > 0);
+
+    fclose(file);
+    MemFree(content);
+}
+
+/* Add an entry for a resource unless it already has one. Returns true if the entry was added. */
+bool AddPrefetchEntry(RaytmxPrefetch* prefetch, RaytmxPrefetchKind kind, const char* fullPath) {
+    if (FindPrefetchEntry(prefetch, kind, fullPath) != NULL)
+        return false;
+
+    if (prefetch->entriesLength == prefetch->entriesCapacity) {
+        uint32_t newCapacity = prefetch->entriesCapacity > 0 ? prefetch->entriesCapacity * 2 : 8;
+        RaytmxPrefetchEntry* newEntries = (RaytmxPrefetchEntry*)MemRealloc(prefetch->entries,
+            newCapacity * (unsigned int)sizeof(RaytmxPrefetchEntry));
+        if (newEntries == NULL)
+            return false; /* The parser will load it instead */
+        prefetch->entries = newEntries;
+        prefetch->entriesCapacity = newCapacity;
+    }
+
+    RaytmxPrefetchEntry* entry = &prefetch->entries[prefetch->entriesLength++];
+    memset(entry, 0, sizeof(RaytmxPrefetchEntry));
+    entry->kind = kind;
+    entry->fullPath = (char*)MemAllocZero((unsigned int)strlen(fullPath) + 1);
+    StringCopy(entry->fullPath, fullPath);
+    return true;
+}
+
+/* Load one prefetch entry on whichever thread RunTasks() gave it to */
+void RunPrefetchTask(void* tasks, uint32_t index) {
+    RaytmxPrefetchEntry* entry = (RaytmxPrefetchEntry*)tasks + index;
+    if (entry->kind == PREFETCH_IMAGE) {
+        entry->image = LoadImage(entry->fullPath);
+        return;
+    }
+
+    /* Textures can only be loaded on the thread with the OpenGL context so tilesets are parsed without them, then */
+    /* LoadTilesetTextures() fills them in. The parse also mustn't take entries meant for the caller's document. */
+    bool wasDeferringTextures = tmxDeferTextures;
+    RaytmxPrefetch* callerPrefetch = tmxPrefetch;
+    tmxDeferTextures = true;
+    tmxPrefetch = NULL;
+    if (entry->kind == PREFETCH_TSX)
+        entry->externalTileset = LoadTSX(entry->fullPath);
+    else
+        entry->objectTemplate = LoadTX(entry->fullPath);
+    tmxDeferTextures = wasDeferringTextures;
+    tmxPrefetch = callerPrefetch;
+}
+
+/* Find the entry for a resource that hasn't been claimed yet, or NULL if it wasn't prefetched */
+RaytmxPrefetchEntry* FindPrefetchEntry(RaytmxPrefetch* prefetch, RaytmxPrefetchKind kind, const char* fullPath) {
+    if (prefetch == NULL)
+        return NULL;
+
+    for (uint32_t i = 0; i < prefetch->entriesLength; i++) {
+        RaytmxPrefetchEntry* entry = &prefetch->entries[i];
+        if (entry->kind == kind && !entry->isClaimed && strcmp(entry->fullPath, fullPath) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+/* Load the textures of a tileset that was parsed with them deferred, sharing them between images of the same file */
+/* like LoadCachedTexture() would have during the parse */
+void LoadTilesetTextures(TmxTileset* tileset, const char* documentDirectory) {
+    RaytmxState raytmxState[1];
+    memset(raytmxState, 0, sizeof(RaytmxState));
+    GetTilesetDirectory(raytmxState->documentDirectory, tileset, documentDirectory);
+
+    RaytmxCachedTextureNode* cachedTexture;
+    if (tileset->hasImage && tileset->image.source != NULL &&
+            (cachedTexture = LoadCachedTexture(raytmxState, tileset->image.source)) != NULL)
+        tileset->image.texture = cachedTexture->texture;
+    for (uint32_t i = 0; i < tileset->tilesLength; i++) {
+        TmxTilesetTile* tile = &tileset->tiles[i];
+        if (tile->hasImage && tile->image.source != NULL &&
+                (cachedTexture = LoadCachedTexture(raytmxState, tile->image.source)) != NULL)
+            tile->image.texture = cachedTexture->texture;
+    }
+
+    FreeState(raytmxState);
+}
+
+/* Get the directory a tileset's image paths are relative to: that of its TSX file if it has one, otherwise that of */
+/* the document it's embedded in */
+void GetTilesetDirectory(char* tilesetDirectory, const TmxTileset* tileset, const char* documentDirectory) {
+    if (tileset->source != NULL)
+        StringCopy(tilesetDirectory, GetDirectoryPath2(JoinPath(documentDirectory, tileset->source)));
+    else
+        StringCopy(tilesetDirectory, documentDirectory);
+}
+
+void FreePrefetch(RaytmxPrefetch* prefetch) {
+    for (uint32_t i = 0; i < prefetch->entriesLength; i++) {
+        RaytmxPrefetchEntry* entry = &prefetch->entries[i];
+        if (entry->image.data != NULL)
+            UnloadImage(entry->image);
+        if (!entry->isClaimed) { /* Whatever the parser didn't take is still owned by the entry */
+            if (entry->externalTileset.isSuccess)
+                FreeTileset(entry->externalTileset.tileset);
+            if (entry->objectTemplate.isSuccess)
+                FreeObject(entry->objectTemplate.object);
+            if (entry->objectTemplate.hasTileset)
+                FreeTileset(entry->objectTemplate.tileset);
+        }
+        MemFree(entry->fullPath);
+    }
+    MemFree(prefetch->entries);
+    memset(prefetch, 0, sizeof(RaytmxPrefetch));
+}
+
+/**
+ * Run a number of independent tasks in parallel. The caller's thread and up to RAYTMX_MAX_THREADS - 1 others each
+ * take the next task until there are none left, so long tasks (e.g. decoding a large image) don't hold up short ones.
+ * Returns once every task has finished.
+ *
+ * @param function Function run once for each task, given 'tasks' and the task's index.
+ * @param tasks Array of tasks, passed to 'function' as is.
+ * @param length Number of tasks.
+ */
+void RunTasks(RaytmxTaskFunction function, void* tasks, uint32_t length) {
+#ifdef RAYTMX_THREADS
+    RaytmxTaskQueue taskQueue[1];
+    memset(taskQueue, 0, sizeof(RaytmxTaskQueue));
+    taskQueue->function = function;
+    taskQueue->tasks = tasks;
+    taskQueue->length = length;
+    if (length > 1 && pthread_mutex_init(&taskQueue->mutex, NULL) == 0) {
+        /* One thread for each task beyond the first, which the caller takes, up to the limit */
+        pthread_t threads[RAYTMX_MAX_THREADS - 1];
+        uint32_t threadsLength = 0;
+        while (threadsLength < length - 1 && threadsLength < RAYTMX_MAX_THREADS - 1 &&
+                pthread_create(&threads[threadsLength], NULL, RunTaskQueue, taskQueue) == 0)
+            threadsLength += 1;
+        RunTaskQueue(taskQueue);
+        for (uint32_t i = 0; i < threadsLength; i++)
+            pthread_join(threads[i], NULL);
+        pthread_mutex_destroy(&taskQueue->mutex);
+        return;
+    }
+#endif
+    for (uint32_t i = 0; i < length; i++)
+        function(tasks, i);
+}
+
+#ifdef RAYTMX_THREADS
+void* RunTaskQueue(void* taskQueue) {
+    RaytmxTaskQueue* queue = (RaytmxTaskQueue*)taskQueue;
+    while (true) {
+        pthread_mutex_lock(&queue->mutex);
+        uint32_t index = queue->next < queue->length ? queue->next++ : queue->length;
+        pthread_mutex_unlock(&queue->mutex);
+        if (index == queue->length)
+            return NULL;
+        queue->function(queue->tasks, index);
+    }
+}
+#endif
+
+/**
+ * Build a compiled map (.tmxb file) in memory from a loaded map. See ExportTMXB().
+ *
+ * @param map A map model loaded from the given TMX document.
+ * @param tmxFileName File name and/or path of the TMX document the map was loaded from.
+ * @param length Output parameter assigned the length of the compiled map.
+ * @return The compiled map, allocated with MemAlloc(), or NULL if out of memory.
+ */
+unsigned char* CompileTMXB(const TmxMap* map, const char* tmxFileName, uint32_t* length) {
+    RaytmxTmxbWriter writer[1];
+    memset(writer, 0, sizeof(RaytmxTmxbWriter));
+
+    /* The header comes first but is filled in last, once every offset is known. Everything the map points to is */
+    /* appended after the map itself with each pointer holding an offset and having a relocation to fix it up. */
+    AppendTMXB(writer, NULL, sizeof(RaytmxTmxbHeader));
+    uint32_t mapOffset = AppendTMXB(writer, map, sizeof(TmxMap));
+    if (mapOffset != 0)
+        SetTMXBPointer(writer, mapOffset + offsetof(TmxMap, cache), 0);
+    WriteTMXBString(writer, mapOffset + offsetof(TmxMap, fileName), map->fileName);
+    WriteTMXBProperties(writer, mapOffset + offsetof(TmxMap, properties), map->properties, map->propertiesLength);
+    WriteTMXBTilesets(writer, mapOffset + offsetof(TmxMap, tilesets), map->tilesets, map->tilesetsLength);
+    WriteTMXBLayers(writer, mapOffset + offsetof(TmxMap, layers), map->layers, map->layersLength);
+    WriteTMXBTiles(writer, mapOffset + offsetof(TmxMap, gidsToTiles), map);
+
+    /* Templates were recorded as dependencies while writing objects. The TMX document and its external tilesets are */
+    /* the rest of them. */
+    char mapDirectory[512];
+    StringCopy(mapDirectory, GetDirectoryPath2(tmxFileName));
+    AddTMXBPath(writer, &writer->dependencyPaths, &writer->dependencyPathsLength, &writer->dependencyPathsCapacity,
+        GetFileName(tmxFileName));
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        if (map->tilesets[i].source != NULL) {
+            AddTMXBPath(writer, &writer->dependencyPaths, &writer->dependencyPathsLength,
+                &writer->dependencyPathsCapacity, map->tilesets[i].source);
+        }
+    }
+
+    /* Append the tables read by LoadTMXB() */
+    uint32_t texturesOffset = AppendTMXB(writer, NULL, sizeof(RaytmxTmxbTexture) * writer->texturePathsLength);
+    for (uint32_t i = 0; i < writer->texturePathsLength; i++) {
+        RaytmxTmxbTexture texture;
+        memset(&texture, 0, sizeof(RaytmxTmxbTexture));
+        texture.path = AppendTMXB(writer, writer->texturePaths[i], strlen(writer->texturePaths[i]) + 1);
+        if (!writer->isOutOfMemory)
+            memcpy(writer->data + texturesOffset + sizeof(RaytmxTmxbTexture) * i, &texture, sizeof(RaytmxTmxbTexture));
+    }
+    uint32_t dependenciesOffset =
+        AppendTMXB(writer, NULL, sizeof(RaytmxTmxbDependency) * writer->dependencyPathsLength);
+    for (uint32_t i = 0; i < writer->dependencyPathsLength; i++) {
+        const char* fullPath = JoinPath(mapDirectory, writer->dependencyPaths[i]);
+        RaytmxTmxbDependency dependency;
+        memset(&dependency, 0, sizeof(RaytmxTmxbDependency));
+        dependency.modTime = (int64_t)GetFileModTime(fullPath);
+        dependency.fileLength = (int64_t)GetFileLength(fullPath);
+        dependency.path = AppendTMXB(writer, writer->dependencyPaths[i], strlen(writer->dependencyPaths[i]) + 1);
+        if (!writer->isOutOfMemory) {
+            memcpy(writer->data + dependenciesOffset + sizeof(RaytmxTmxbDependency) * i, &dependency,
+                sizeof(RaytmxTmxbDependency));
+        }
+    }
+    uint32_t relocationsOffset =
+        AppendTMXB(writer, writer->relocations, sizeof(RaytmxTmxbRelocation) * writer->relocationsLength);
+
+    if (writer->isOutOfMemory) {
+        TraceLog(LOG_ERROR, "RAYTMX: Out of memory while compiling map \"%s\"", tmxFileName);
+        FreeTMXBWriter(writer);
+        return NULL;
+    }
+
+    RaytmxTmxbHeader header;
+    memset(&header, 0, sizeof(RaytmxTmxbHeader));
+    memcpy(header.magic, "TMXB", 4);
+    header.version = RAYTMX_TMXB_VERSION;
+    GetTMXBLayout(header.layout);
+    header.length = writer->length;
+    header.mapOffset = mapOffset;
+    header.relocationsOffset = relocationsOffset;
+    header.relocationsLength = writer->relocationsLength;
+    header.texturesOffset = texturesOffset;
+    header.texturesLength = writer->texturePathsLength;
+    header.dependenciesOffset = dependenciesOffset;
+    header.dependenciesLength = writer->dependencyPathsLength;
+    memcpy(writer->data, &header, sizeof(RaytmxTmxbHeader));
+
+    /* Hand the data over to the caller and free the rest */
+    unsigned char* data = writer->data;
+    *length = writer->length;
+    writer->data = NULL;
+    FreeTMXBWriter(writer);
+    return data;
+}
+
+/**
+ * Load a compiled map (.tmxb file) written by ExportTMXB() for the given TMX document. The file is mapped into memory
+ * privately, so the fix-ups made here are never written back to it, and the map is used straight out of that memory.
+ *
+ * @param tmxFileName File name and/or path of the TMX document the compiled map was made from.
+ * @param fileName File name and/or path of the compiled map.
+ * @param deferTextures When true, images are only decoded and left for UploadTexturesTMX() rather than loaded.
+ * @return The compiled map's model of the map, or NULL if the compiled map is missing, invalid, or out of date.
+ */
+TmxMap* LoadTMXB(const char* tmxFileName, const char* fileName, bool deferTextures) {
+    if (!FileExists(fileName))
+        return NULL;
+
+    uint32_t length = 0;
+    unsigned char* data = MapTMXBFile(fileName, &length);
+    if (data == NULL) {
+        TraceLog(LOG_WARNING, "RAYTMX: Unable to read compiled map \"%s\"", fileName);
+        return NULL;
+    }
+
+    char mapDirectory[512];
+    StringCopy(mapDirectory, GetDirectoryPath2(tmxFileName));
+    if (!IsTMXBValid(data, length, mapDirectory)) {
+        TraceLog(LOG_INFO, "RAYTMX: Compiled map \"%s\" is out of date or invalid", fileName);
+        UnmapTMXBFile(data, length);
+        return NULL;
+    }
+
+#ifdef RAYTMX_TMXB_MMAP
+    TmxMap* map = OpenTMXB(data, true, mapDirectory, deferTextures);
+#else
+    TmxMap* map = OpenTMXB(data, false, mapDirectory, deferTextures);
+#endif
+    TraceLog(LOG_INFO, "RAYTMX: Loaded compiled map \"%s\"", fileName);
+    return map;
+}
+
+/**
+ * Fix up a valid compiled map in place, making its pointers absolute and giving it the default font, and then either
+ * load its textures or decode its images for UploadTexturesTMX().
+ *
+ * @param data The compiled map, either memory-mapped or allocated with MemAlloc(). It's owned by the map from now on.
+ * @param isMapped True if the compiled map is memory-mapped.
+ * @param mapDirectory Directory of the TMX document, which the paths in the compiled map are relative to.
+ * @param deferTextures When true, images are only decoded and left for UploadTexturesTMX() rather than loaded.
+ * @return The compiled map's model of the map.
+ */
+TmxMap* OpenTMXB(unsigned char* data, bool isMapped, const char* mapDirectory, bool deferTextures) {
+    RaytmxTmxbHeader* header = (RaytmxTmxbHeader*)data;
+    header->isMapped = isMapped ? 1 : 0;
+
+    /* Textures can't be stored so they're loaded now, or their images decoded, once per image file. The images are */
+    /* decoded in parallel and then, unless deferred, turned into textures here on the caller's thread. */
+    RaytmxTmxbTexture* textures = (RaytmxTmxbTexture*)(data + header->texturesOffset);
+    RaytmxPrefetch prefetch[1];
+    memset(prefetch, 0, sizeof(RaytmxPrefetch));
+    for (uint32_t i = 0; i < header->texturesLength; i++) {
+        memset(&textures[i].texture, 0, sizeof(Texture2D));
+        memset(&textures[i].image, 0, sizeof(Image));
+        if (tmxLoadTextures) /* With texture loading disabled, leave the images' textures zeroed */
+            AddPrefetchEntry(prefetch, PREFETCH_IMAGE, JoinPath(mapDirectory, (const char*)data + textures[i].path));
+    }
+    RunTasks(RunPrefetchTask, prefetch->entries, prefetch->entriesLength);
+    for (uint32_t i = 0; i < header->texturesLength && tmxLoadTextures; i++) {
+        const char* fullPath = JoinPath(mapDirectory, (const char*)data + textures[i].path);
+        RaytmxPrefetchEntry* prefetched = FindPrefetchEntry(prefetch, PREFETCH_IMAGE, fullPath);
+        Image image = prefetched != NULL ? prefetched->image : LoadImage(fullPath);
+        if (prefetched != NULL)
+            memset(&prefetched->image, 0, sizeof(Image)); /* Owned by the compiled map from now on */
+        if (image.data == NULL) {
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to load image \"%s\"", fullPath);
+            continue;
+        }
+        if (deferTextures)
+            textures[i].image = image;
+        else {
+            textures[i].texture = LoadTextureFromImage(image);
+            UnloadImage(image);
+            if (textures[i].texture.id == 0)
+                TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", fullPath);
+        }
+    }
+    FreePrefetch(prefetch);
+    header->texturesUploaded = deferTextures ? 0 : header->texturesLength;
+
+    /* Make every pointer absolute and fill in the fonts */
+    const RaytmxTmxbRelocation* relocations = (const RaytmxTmxbRelocation*)(data + header->relocationsOffset);
+    Font font = GetFontDefault();
+    for (uint32_t i = 0; i < header->relocationsLength; i++) {
+        unsigned char* target = data + relocations[i].offset;
+        if (relocations[i].kind == TMXB_RELOCATE_POINTER) {
+            uintptr_t pointer;
+            memcpy(&pointer, target, sizeof(uintptr_t));
+            pointer += (uintptr_t)data;
+            memcpy(target, &pointer, sizeof(uintptr_t));
+        } else if (relocations[i].kind == TMXB_RELOCATE_FONT)
+            memcpy(target, &font, sizeof(Font));
+    }
+    if (!deferTextures)
+        RelocateTMXBTextures(data);
+
+    TmxMap* map = (TmxMap*)(data + header->mapOffset);
+    map->cache = data;
+    if (!deferTextures && tmxBakeTileLayers && tmxLoadTextures)
+        BakeTMXTileLayers(map, map->layers, map->layersLength);
+    return map;
+}
+
+/* Copy each of the compiled map's textures to every tileset, tile, and image layer that uses it */
+void RelocateTMXBTextures(unsigned char* data) {
+    const RaytmxTmxbHeader* header = (const RaytmxTmxbHeader*)data;
+    const RaytmxTmxbTexture* textures = (const RaytmxTmxbTexture*)(data + header->texturesOffset);
+    const RaytmxTmxbRelocation* relocations = (const RaytmxTmxbRelocation*)(data + header->relocationsOffset);
+    for (uint32_t i = 0; i < header->relocationsLength; i++) {
+        if (relocations[i].kind == TMXB_RELOCATE_TEXTURE)
+            memcpy(data + relocations[i].offset, &textures[relocations[i].texture].texture, sizeof(Texture2D));
+    }
+}
+
+void UnloadTMXB(void* cache) {
+    unsigned char* data = (unsigned char*)cache;
+    RaytmxTmxbHeader header;
+    memcpy(&header, data, sizeof(RaytmxTmxbHeader));
+
+    const RaytmxTmxbTexture* textures = (const RaytmxTmxbTexture*)(data + header.texturesOffset);
+    for (uint32_t i = 0; i < header.texturesLength; i++) {
+        if (textures[i].texture.id != 0) /* Zero if loading failed or textures were disabled */
+            UnloadTexture(textures[i].texture);
+        if (textures[i].image.data != NULL) /* If the map was unloaded before this image was uploaded */
+            UnloadImage(textures[i].image);
+    }
+
+    if (header.isMapped)
+        UnmapTMXBFile(data, header.length);
+    else
+        MemFree(data);
+}
+
+/**
+ * Get the file name a TMX document's compiled map is cached under: "level.tmx" is cached as "level.tmxb" while any
+ * other file name has the whole extension appended.
+ *
+ * @param cacheFileName Output buffer for the compiled map's file name.
+ * @param size Size of the output buffer.
+ * @param fileName File name and/or path of the TMX document.
+ * @return True if the compiled map's file name fit in the output buffer.
+ */
+bool GetTMXBFileName(char* cacheFileName, size_t size, const char* fileName) {
+    size_t length = strlen(fileName);
+    if (length + 6 > size) {
+        TraceLog(LOG_WARNING, "RAYTMX: Path of \"%s\" is too long to be cached", fileName);
+        return false;
+    }
+    StringCopy(cacheFileName, fileName);
+    StringConcatenate(cacheFileName, length >= 4 && strcmp(fileName + length - 4, ".tmx") == 0 ? "b" : ".tmxb");
+    return true;
+}
+
+bool WriteTMXBFile(const unsigned char* data, uint32_t length, const char* fileName) {
+    /* The compiled map is written to a uniquely named file beside the cache and then renamed over it. Processes */
+    /* sharing the cache (e.g. parallel batch runs) that are reading or have mapped the old file keep their complete */
+    /* copy, and none of them ever opens a partially written one. */
+    static uint32_t tempCounter = 0; /* Racy between threads, but a clash only costs another attempt */
+    size_t tempFileNameSize = strlen(fileName) + 32;
+    char* tempFileName = (char*)MemAlloc((unsigned int)tempFileNameSize);
+    if (tempFileName == NULL)
+        return false;
+
+    bool isCreated = false; /* Only a temporary file this call created may be removed, never another process's */
+    bool isSuccess = false;
+#ifdef RAYTMX_TMXB_MMAP
+    int file = -1;
+    for (uint32_t attempt = 0; file < 0 && attempt < 16; attempt++) {
+        snprintf(tempFileName, tempFileNameSize, "%s.%lu.%u.tmp", fileName, (unsigned long)getpid(), tempCounter++);
+        file = open(tempFileName, O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (file < 0 && errno != EEXIST)
+            break;
+    }
+    if (file >= 0) {
+        isCreated = isSuccess = true;
+        for (uint32_t written = 0; isSuccess && written < length;) {
+            ssize_t result = write(file, data + written, length - written);
+            if (result > 0)
+                written += (uint32_t)result;
+            else if (result < 0 && errno == EINTR)
+                continue;
+            else
+                isSuccess = false;
+        }
+        if (close(file) != 0)
+            isSuccess = false;
+    }
+#else
+    /* No exclusive create in standard C, so the name is made unlikely to clash between processes instead */
+    if (tempCounter == 0)
+        tempCounter = (uint32_t)time(NULL);
+    snprintf(tempFileName, tempFileNameSize, "%s.%u.tmp", fileName, tempCounter++);
+    FILE* file = fopen(tempFileName, "wb");
+    if (file != NULL) {
+        isCreated = true;
+        isSuccess = fwrite(data, 1, length, file) == length;
+        if (fclose(file) != 0)
+            isSuccess = false;
+    }
+#endif
+
+    if (isSuccess && rename(tempFileName, fileName) != 0) {
+#ifdef _WIN32
+        /* Windows won't rename over an existing file. Replacing it is then no longer atomic, but a reader that */
+        /* catches the gap only misses the cache, and an open cache can't be removed there at all. */
+        isSuccess = remove(fileName) == 0 && rename(tempFileName, fileName) == 0;
+#else
+        isSuccess = false;
+#endif
+    }
+    if (!isSuccess && isCreated)
+        remove(tempFileName); /* Don't leave a partial file behind */
+    MemFree(tempFileName);
+    return isSuccess;
+}
+
+unsigned char* MapTMXBFile(const char* fileName, uint32_t* length) {
+    unsigned char* data = NULL;
+#ifdef RAYTMX_TMXB_MMAP
+    int file = open(fileName, O_RDONLY);
+    if (file < 0)
+        return NULL;
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0 && (uint64_t)fileStat.st_size <= UINT32_MAX) {
+        /* Mapped privately and writable so the fix-ups are copy-on-write, touching only the pages they're on */
+        void* mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED) {
+            data = (unsigned char*)mapping;
+            *length = (uint32_t)fileStat.st_size;
+        }
+    }
+    close(file);
+#else
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL)
+        return NULL;
+
+    long size = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    if (size > 0 && (uint64_t)size <= UINT32_MAX && fseek(file, 0, SEEK_SET) == 0) {
+        data = (unsigned char*)MemAlloc((unsigned int)size);
+        if (data != NULL && fread(data, 1, (size_t)size, file) != (size_t)size) {
+            MemFree(data);
+            data = NULL;
+        } else
+            *length = (uint32_t)size;
+    }
+    fclose(file);
+#endif
+    return data;
+}
+
+void UnmapTMXBFile(unsigned char* data, uint32_t length) {
+#ifdef RAYTMX_TMXB_MMAP
+    munmap(data, length);
+#else
+    (void)length;
+    MemFree(data);
+#endif
+}
+
+/**
+ * Check that a compiled map was written by a compatible build of raytmx, that every offset in it stays within the
+ * file, and that none of the files it was made from have changed since.
+ *
+ * @param data The whole compiled map as read from disk, before any fix-ups.
+ * @param length Length of the compiled map in bytes.
+ * @param mapDirectory Directory of the TMX document, which the paths in the compiled map are relative to.
+ * @return True if the compiled map can be used in place of its TMX document.
+ */
+bool IsTMXBValid(const unsigned char* data, uint32_t length, const char* mapDirectory) {
+    if (length < sizeof(RaytmxTmxbHeader))
+        return false;
+
+    RaytmxTmxbHeader header;
+    memcpy(&header, data, sizeof(RaytmxTmxbHeader));
+    uint32_t layout[10];
+    GetTMXBLayout(layout);
+    if (memcmp(header.magic, "TMXB", 4) != 0 || header.version != RAYTMX_TMXB_VERSION ||
+        memcmp(header.layout, layout, sizeof(layout)) != 0 || header.length != length)
+        return false;
+
+    /* Every table must lie within the file and start on a boundary suitable for its contents */
+    uint64_t mapEnd = (uint64_t)header.mapOffset + sizeof(TmxMap);
+    uint64_t relocationsEnd =
+        (uint64_t)header.relocationsOffset + (uint64_t)header.relocationsLength * sizeof(RaytmxTmxbRelocation);
+    uint64_t texturesEnd = (uint64_t)header.texturesOffset + (uint64_t)header.texturesLength * sizeof(RaytmxTmxbTexture);
+    uint64_t dependenciesEnd =
+        (uint64_t)header.dependenciesOffset + (uint64_t)header.dependenciesLength * sizeof(RaytmxTmxbDependency);
+    if (mapEnd > length || relocationsEnd > length || texturesEnd > length || dependenciesEnd > length ||
+        (header.mapOffset | header.relocationsOffset | header.texturesOffset | header.dependenciesOffset) %
+        RAYTMX_TMXB_ALIGNMENT != 0)
+        return false;
+
+    /* Paths must be terminated within the file */
+    const RaytmxTmxbTexture* textures = (const RaytmxTmxbTexture*)(data + header.texturesOffset);
+    for (uint32_t i = 0; i < header.texturesLength; i++) {
+        if (textures[i].path >= length || memchr(data + textures[i].path, '\0', length - textures[i].path) == NULL)
+            return false;
+    }
+
+    /* Every fix-up must stay within the file and every pointer must point into it */
+    const RaytmxTmxbRelocation* relocations = (const RaytmxTmxbRelocation*)(data + header.relocationsOffset);
+    for (uint32_t i = 0; i < header.relocationsLength; i++) {
+        uint64_t offset = relocations[i].offset;
+        if (relocations[i].kind == TMXB_RELOCATE_POINTER) {
+            uintptr_t pointer;
+            if (offset + sizeof(uintptr_t) > length)
+                return false;
+            memcpy(&pointer, data + offset, sizeof(uintptr_t));
+            if (pointer >= length)
+                return false;
+        } else if (relocations[i].kind == TMXB_RELOCATE_TEXTURE) {
+            if (offset + sizeof(Texture2D) > length || relocations[i].texture >= header.texturesLength)
+                return false;
+        } else if (relocations[i].kind == TMXB_RELOCATE_FONT) {
+            if (offset + sizeof(Font) > length)
+                return false;
+        } else
+            return false;
+    }
+
+    /* The compiled map is out of date if any of the files it was made from changed, going by modification time and */
+    /* size rather than hashing every file, which would take about as long as parsing them */
+    const RaytmxTmxbDependency* dependencies = (const RaytmxTmxbDependency*)(data + header.dependenciesOffset);
+    for (uint32_t i = 0; i < header.dependenciesLength; i++) {
+        uint32_t path = dependencies[i].path;
+        if (path >= length || memchr(data + path, '\0', length - path) == NULL)
+            return false;
+        const char* fullPath = JoinPath(mapDirectory, (const char*)data + path);
+        if (!FileExists(fullPath) || (int64_t)GetFileModTime(fullPath) != dependencies[i].modTime ||
+            (int64_t)GetFileLength(fullPath) != dependencies[i].fileLength)
+            return false;
+    }
+
+    return true;
+}
+
+void GetTMXBLayout(uint32_t* layout) {
+    layout[0] = (uint32_t)sizeof(void*);
+    layout[1] = (uint32_t)sizeof(TmxMap);
+    layout[2] = (uint32_t)sizeof(TmxLayer);
+    layout[3] = (uint32_t)sizeof(TmxTileset);
+    layout[4] = (uint32_t)sizeof(TmxTilesetTile);
+    layout[5] = (uint32_t)sizeof(TmxTile);
+    layout[6] = (uint32_t)sizeof(TmxObject);
+    layout[7] = (uint32_t)sizeof(TmxText);
+    layout[8] = (uint32_t)sizeof(TmxTextLine);
+    layout[9] = (uint32_t)sizeof(TmxProperty);
+}
+
+bool ReserveTMXB(RaytmxTmxbWriter* writer, void** array, uint32_t* capacity, uint32_t needed, size_t elementSize) {
+    if (needed <= *capacity)
+        return true;
+
+    uint64_t newCapacity = *capacity > 0 ? *capacity : 16;
+    while (newCapacity < needed)
+        newCapacity *= 2;
+    if (newCapacity * elementSize > UINT32_MAX) {
+        writer->isOutOfMemory = true;
+        return false;
+    }
+
+    void* newArray = MemRealloc(*array, (unsigned int)(newCapacity * elementSize));
+    if (newArray == NULL) {
+        writer->isOutOfMemory = true;
+        return false;
+    }
+    *array = newArray;
+    *capacity = (uint32_t)newCapacity;
+    return true;
+}
+
+/**
+ * Append a copy of the given memory, or zeroes, to a compiled map being written. Pointers to the compiled map's data
+ * are invalidated by this so its contents must always be addressed by offset while writing.
+ *
+ * @param writer The compiled map being written.
+ * @param source (Optional) memory to be copied. If NULL, the appended bytes are zeroed.
+ * @param size Number of bytes to append.
+ * @return Offset of the appended bytes within the compiled map, always aligned, or zero if out of memory.
+ */
+uint32_t AppendTMXB(RaytmxTmxbWriter* writer, const void* source, size_t size) {
+    if (writer->isOutOfMemory)
+        return 0;
+
+    uint64_t offset = ((uint64_t)writer->length + RAYTMX_TMXB_ALIGNMENT - 1) & ~(uint64_t)(RAYTMX_TMXB_ALIGNMENT - 1);
+    if (offset + size > UINT32_MAX) {
+        writer->isOutOfMemory = true;
+        return 0;
+    }
+    if (!ReserveTMXB(writer, (void**)&writer->data, &writer->capacity, (uint32_t)(offset + size), 1))
+        return 0;
+
+    memset(writer->data + writer->length, 0, (size_t)(offset - writer->length)); /* Padding */
+    if (source != NULL)
+        memcpy(writer->data + offset, source, size);
+    else
+        memset(writer->data + offset, 0, size);
+    writer->length = (uint32_t)(offset + size);
+    return (uint32_t)offset;
+}
+
+/**
+ * Append a copy of the given array to a compiled map being written unless the same array was already appended, in
+ * which case the existing copy is reused. Arrays like animation frames and object groups are shared between the
+ * tilesets and 'gidsToTiles' and must stay shared.
+ *
+ * @param writer The compiled map being written.
+ * @param source The array to be copied, identified by its address.
+ * @param size Size of the array in bytes.
+ * @param isNew Output parameter set to true if the array was appended now and its members still need to be written.
+ * @return Offset of the array's copy within the compiled map, or zero if NULL, empty, or out of memory.
+ */
+uint32_t AppendTMXBBlock(RaytmxTmxbWriter* writer, const void* source, size_t size, bool* isNew) {
+    *isNew = false;
+    if (source == NULL || size == 0 || writer->isOutOfMemory)
+        return 0;
+
+    /* Keep the hash table at most half full, rehashing everything into one twice the size when it isn't */
+    if (writer->blocksLength * 2 >= writer->blocksCapacity) {
+        uint32_t capacity = writer->blocksCapacity > 0 ? writer->blocksCapacity * 2 : 256;
+        RaytmxTmxbBlock* blocks = (RaytmxTmxbBlock*)MemAllocZero(sizeof(RaytmxTmxbBlock) * capacity);
+        if (blocks == NULL) {
+            writer->isOutOfMemory = true;
+            return 0;
+        }
+        for (uint32_t i = 0; i < writer->blocksCapacity; i++) {
+            if (writer->blocks[i].source == NULL)
+                continue;
+            uint32_t j = (uint32_t)(((uintptr_t)writer->blocks[i].source >> 3) * 2654435761u) & (capacity - 1);
+            while (blocks[j].source != NULL)
+                j = (j + 1) & (capacity - 1);
+            blocks[j] = writer->blocks[i];
+        }
+        if (writer->blocks != NULL)
+            MemFree(writer->blocks);
+        writer->blocks = blocks;
+        writer->blocksCapacity = capacity;
+    }
+
+    uint32_t i = (uint32_t)(((uintptr_t)source >> 3) * 2654435761u) & (writer->blocksCapacity - 1);
+    while (writer->blocks[i].source != NULL) {
+        if (writer->blocks[i].source == source)
+            return writer->blocks[i].offset;
+        i = (i + 1) & (writer->blocksCapacity - 1);
+    }
+
+    uint32_t offset = AppendTMXB(writer, source, size);
+    if (offset == 0)
+        return 0;
+    writer->blocks[i].source = source;
+    writer->blocks[i].offset = offset;
+    writer->blocksLength++;
+    *isNew = true;
+    return offset;
+}
+
+uint32_t AddTMXBPath(RaytmxTmxbWriter* writer, char*** paths, uint32_t* pathsLength, uint32_t* pathsCapacity,
+    const char* path) {
+    for (uint32_t i = 0; i < *pathsLength; i++) {
+        if (strcmp((*paths)[i], path) == 0)
+            return i;
+    }
+
+    if (!ReserveTMXB(writer, (void**)paths, pathsCapacity, *pathsLength + 1, sizeof(char*)))
+        return 0;
+    char* copy = (char*)MemAllocZero((unsigned int)strlen(path) + 1);
+    if (copy == NULL) {
+        writer->isOutOfMemory = true;
+        return 0;
+    }
+    StringCopy(copy, path);
+    (*paths)[*pathsLength] = copy;
+    return (*pathsLength)++;
+}
+
+void AddTMXBRelocation(RaytmxTmxbWriter* writer, RaytmxTmxbRelocationKind kind, uint32_t offset, uint32_t texture) {
+    if (!ReserveTMXB(writer, (void**)&writer->relocations, &writer->relocationsCapacity,
+        writer->relocationsLength + 1, sizeof(RaytmxTmxbRelocation)))
+        return;
+
+    RaytmxTmxbRelocation* relocation = &writer->relocations[writer->relocationsLength++];
+    relocation->kind = (uint32_t)kind;
+    relocation->offset = offset;
+    relocation->texture = texture;
+}
+
+/**
+ * Set a pointer within a compiled map being written to the given offset and have it fixed up when loaded.
+ *
+ * @param writer The compiled map being written.
+ * @param slot Offset of the pointer within the compiled map.
+ * @param target Offset the pointer is to point to, or zero for NULL.
+ */
+void SetTMXBPointer(RaytmxTmxbWriter* writer, uint32_t slot, uint32_t target) {
+    if (writer->isOutOfMemory)
+        return;
+
+    uintptr_t pointer = target;
+    memcpy(writer->data + slot, &pointer, sizeof(uintptr_t));
+    if (target != 0) /* NULL stays NULL */
+        AddTMXBRelocation(writer, TMXB_RELOCATE_POINTER, slot, 0);
+}
+
+void WriteTMXBString(RaytmxTmxbWriter* writer, uint32_t slot, const char* string) {
+    SetTMXBPointer(writer, slot, string != NULL ? AppendTMXB(writer, string, strlen(string) + 1) : 0);
+}
+
+/**
+ * Clear a texture within a compiled map being written and have it set to the texture of the given image when loaded.
+ *
+ * @param writer The compiled map being written.
+ * @param slot Offset of the Texture2D within the compiled map.
+ * @param imageSource (Optional) image's path relative to the document it was found in. If NULL, the texture is cleared.
+ * @param documentPath (Optional) path of the document, an external tileset, relative to the TMX document's directory.
+ *                     If NULL, the image was found in the TMX document.
+ */
+void WriteTMXBTexture(RaytmxTmxbWriter* writer, uint32_t slot, const char* imageSource, const char* documentPath) {
+    if (writer->isOutOfMemory)
+        return;
+
+    memset(writer->data + slot, 0, sizeof(Texture2D)); /* Never store a texture ID from this run of the program */
+    if (imageSource == NULL)
+        return;
+
+    /* Images are relative to the document they're in, so make those in external tilesets relative to the map */
+    char path[512] = "";
+    bool isAbsolute = imageSource[0] == '/' || imageSource[0] == '\\' ||
+        (imageSource[0] != '\0' && imageSource[1] == ':');
+    if (!isAbsolute && documentPath != NULL) {
+        const char* lastSlash = strrchr(documentPath, '/');
+        const char* lastBackslash = strrchr(documentPath, '\\');
+        if (lastBackslash != NULL && (lastSlash == NULL || lastBackslash > lastSlash))
+            lastSlash = lastBackslash;
+        if (lastSlash != NULL && (size_t)(lastSlash - documentPath) + 1 < sizeof(path))
+            StringCopyN(path, documentPath, (size_t)(lastSlash - documentPath) + 1);
+    }
+    if (strlen(path) + strlen(imageSource) >= sizeof(path)) {
+        TraceLog(LOG_WARNING, "RAYTMX: Path of image \"%s\" is too long to be compiled", imageSource);
+        return;
+    }
+    StringConcatenate(path, imageSource);
+
+    uint32_t texture = AddTMXBPath(writer, &writer->texturePaths, &writer->texturePathsLength,
+        &writer->texturePathsCapacity, path);
+    AddTMXBRelocation(writer, TMXB_RELOCATE_TEXTURE, slot, texture);
+}
+
+void WriteTMXBImage(RaytmxTmxbWriter* writer, uint32_t image, const TmxImage* source, const char* documentPath) {
+    WriteTMXBString(writer, image + offsetof(TmxImage, source), source->source);
+    WriteTMXBTexture(writer, image + offsetof(TmxImage, texture), source->source, documentPath);
+}
+
+void WriteTMXBProperties(RaytmxTmxbWriter* writer, uint32_t slot, const TmxProperty* properties, uint32_t length) {
+    bool isNew;
+    uint32_t offset = AppendTMXBBlock(writer, properties, sizeof(TmxProperty) * length, &isNew);
+    SetTMXBPointer(writer, slot, offset);
+    if (!isNew)
+        return;
+
+    for (uint32_t i = 0; i < length; i++) {
+        uint32_t property = offset + (uint32_t)sizeof(TmxProperty) * i;
+        WriteTMXBString(writer, property + offsetof(TmxProperty, name), properties[i].name);
+        WriteTMXBString(writer, property + offsetof(TmxProperty, stringValue), properties[i].stringValue);
+    }
+}
+
+void WriteTMXBObjectGroup(RaytmxTmxbWriter* writer, uint32_t group, const TmxObjectGroup* source) {
+    bool isNew, isSortingNew;
+    uint32_t objects = AppendTMXBBlock(writer, source->objects, sizeof(TmxObject) * source->objectsLength, &isNew);
+    SetTMXBPointer(writer, group + offsetof(TmxObjectGroup, objects), objects);
+    uint32_t ySortedObjects = AppendTMXBBlock(writer, source->ySortedObjects,
+        sizeof(uint32_t) * source->objectsLength, &isSortingNew);
+    SetTMXBPointer(writer, group + offsetof(TmxObjectGroup, ySortedObjects), ySortedObjects);
+    if (!isNew)
+        return;
+
+    for (uint32_t i = 0; i < source->objectsLength; i++) {
+        const TmxObject* object = &source->objects[i];
+        uint32_t o = objects + (uint32_t)sizeof(TmxObject) * i;
+        WriteTMXBString(writer, o + offsetof(TmxObject, name), object->name);
+        WriteTMXBString(writer, o + offsetof(TmxObject, typeString), object->typeString);
+        WriteTMXBString(writer, o + offsetof(TmxObject, templateString), object->templateString);
+        if (object->templateString != NULL) {
+            AddTMXBPath(writer, &writer->dependencyPaths, &writer->dependencyPathsLength,
+                &writer->dependencyPathsCapacity, object->templateString);
+        }
+        SetTMXBPointer(writer, o + offsetof(TmxObject, points), object->points != NULL && object->pointsLength > 0 ?
+            AppendTMXB(writer, object->points, sizeof(Vector2) * object->pointsLength) : 0);
+        SetTMXBPointer(writer, o + offsetof(TmxObject, drawPoints),
+            object->drawPoints != NULL && object->pointsLength > 0 ?
+            AppendTMXB(writer, object->drawPoints, sizeof(Vector2) * object->pointsLength) : 0);
+        WriteTMXBProperties(writer, o + offsetof(TmxObject, properties), object->properties,
+            object->propertiesLength);
+
+        uint32_t text = object->text != NULL ? AppendTMXB(writer, object->text, sizeof(TmxText)) : 0;
+        SetTMXBPointer(writer, o + offsetof(TmxObject, text), text);
+        if (text == 0)
+            continue;
+        WriteTMXBString(writer, text + offsetof(TmxText, fontFamily), object->text->fontFamily);
+        WriteTMXBString(writer, text + offsetof(TmxText, content), object->text->content);
+        uint32_t lines = object->text->lines != NULL && object->text->linesLength > 0 ?
+            AppendTMXB(writer, object->text->lines, sizeof(TmxTextLine) * object->text->linesLength) : 0;
+        SetTMXBPointer(writer, text + offsetof(TmxText, lines), lines);
+        for (uint32_t j = 0; lines != 0 && j < object->text->linesLength; j++) {
+            uint32_t line = lines + (uint32_t)sizeof(TmxTextLine) * j;
+            WriteTMXBString(writer, line + offsetof(TmxTextLine, content), object->text->lines[j].content);
+            if (!writer->isOutOfMemory) { /* Like textures, fonts can't be stored and are set when loaded */
+                memset(writer->data + line + offsetof(TmxTextLine, font), 0, sizeof(Font));
+                AddTMXBRelocation(writer, TMXB_RELOCATE_FONT, line + offsetof(TmxTextLine, font), 0);
+            }
+        }
+    }
+}
+
+void WriteTMXBTilesets(RaytmxTmxbWriter* writer, uint32_t slot, const TmxTileset* tilesets, uint32_t length) {
+    bool isNew;
+    uint32_t offset = AppendTMXBBlock(writer, tilesets, sizeof(TmxTileset) * length, &isNew);
+    SetTMXBPointer(writer, slot, offset);
+    if (!isNew)
+        return;
+
+    for (uint32_t i = 0; i < length; i++) {
+        const TmxTileset* tileset = &tilesets[i];
+        uint32_t t = offset + (uint32_t)sizeof(TmxTileset) * i;
+        WriteTMXBString(writer, t + offsetof(TmxTileset, source), tileset->source);
+        WriteTMXBString(writer, t + offsetof(TmxTileset, name), tileset->name);
+        WriteTMXBString(writer, t + offsetof(TmxTileset, classString), tileset->classString);
+        WriteTMXBImage(writer, t + offsetof(TmxTileset, image), &tileset->image, tileset->source);
+        WriteTMXBProperties(writer, t + offsetof(TmxTileset, properties), tileset->properties,
+            tileset->propertiesLength);
+
+        bool areTilesNew;
+        uint32_t tiles = AppendTMXBBlock(writer, tileset->tiles, sizeof(TmxTilesetTile) * tileset->tilesLength,
+            &areTilesNew);
+        SetTMXBPointer(writer, t + offsetof(TmxTileset, tiles), tiles);
+        for (uint32_t j = 0; areTilesNew && j < tileset->tilesLength; j++) {
+            const TmxTilesetTile* tile = &tileset->tiles[j];
+            uint32_t tt = tiles + (uint32_t)sizeof(TmxTilesetTile) * j;
+            bool areFramesNew;
+            WriteTMXBImage(writer, tt + offsetof(TmxTilesetTile, image), &tile->image, tileset->source);
+            SetTMXBPointer(writer, tt + offsetof(TmxTilesetTile, animation) + offsetof(TmxAnimation, frames),
+                AppendTMXBBlock(writer, tile->animation.frames,
+                sizeof(TmxAnimationFrame) * tile->animation.framesLength, &areFramesNew));
+            WriteTMXBProperties(writer, tt + offsetof(TmxTilesetTile, properties), tile->properties,
+                tile->propertiesLength);
+            WriteTMXBObjectGroup(writer, tt + offsetof(TmxTilesetTile, objectGroup), &tile->objectGroup);
+        }
+    }
+}
+
+void WriteTMXBLayers(RaytmxTmxbWriter* writer, uint32_t slot, const TmxLayer* layers, uint32_t length) {
+    bool isNew;
+    uint32_t offset = AppendTMXBBlock(writer, layers, sizeof(TmxLayer) * length, &isNew);
+    SetTMXBPointer(writer, slot, offset);
+    if (!isNew)
+        return;
+
+    for (uint32_t i = 0; i < length; i++) {
+        const TmxLayer* layer = &layers[i];
+        uint32_t l = offset + (uint32_t)sizeof(TmxLayer) * i;
+        uint32_t exact = l + offsetof(TmxLayer, exact);
+        WriteTMXBString(writer, l + offsetof(TmxLayer, name), layer->name);
+        WriteTMXBString(writer, l + offsetof(TmxLayer, classString), layer->classString);
+        WriteTMXBProperties(writer, l + offsetof(TmxLayer, properties), layer->properties, layer->propertiesLength);
+        WriteTMXBLayers(writer, l + offsetof(TmxLayer, layers), layer->layers, layer->layersLength);
+
+        switch (layer->type) {
+        case LAYER_TYPE_TILE_LAYER: {
+            const TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+            WriteTMXBString(writer, exact + offsetof(TmxTileLayer, encoding), tileLayer->encoding);
+            WriteTMXBString(writer, exact + offsetof(TmxTileLayer, compression), tileLayer->compression);
+            SetTMXBPointer(writer, exact + offsetof(TmxTileLayer, tiles),
+                tileLayer->tiles != NULL && tileLayer->tilesLength > 0 ?
+                AppendTMXB(writer, tileLayer->tiles, sizeof(uint32_t) * tileLayer->tilesLength) : 0);
+            SetTMXBPointer(writer, exact + offsetof(TmxTileLayer, chunks), 0); /* Baked again once loaded */
+        } break;
+        case LAYER_TYPE_OBJECT_GROUP:
+            WriteTMXBObjectGroup(writer, exact, &layer->exact.objectGroup);
+            break;
+        case LAYER_TYPE_IMAGE_LAYER:
+            WriteTMXBImage(writer, exact + offsetof(TmxImageLayer, image), &layer->exact.imageLayer.image, NULL);
+            break;
+        default: /* Group layers only have the child layers written above */
+            break;
+        }
+    }
+}
+
+void WriteTMXBTiles(RaytmxTmxbWriter* writer, uint32_t slot, const TmxMap* map) {
+    bool isNew;
+    uint32_t offset = AppendTMXBBlock(writer, map->gidsToTiles, sizeof(TmxTile) * map->gidsToTilesLength, &isNew);
+    SetTMXBPointer(writer, slot, offset);
+    if (!isNew)
+        return;
+
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        const TmxTile* tile = &map->gidsToTiles[gid];
+        uint32_t t = offset + (uint32_t)sizeof(TmxTile) * gid;
+        bool areFramesNew;
+        /* Animation frames and object groups are the same arrays as in the tileset tiles, found already written */
+        SetTMXBPointer(writer, t + offsetof(TmxTile, animation) + offsetof(TmxAnimation, frames),
+            AppendTMXBBlock(writer, tile->animation.frames, sizeof(TmxAnimationFrame) * tile->animation.framesLength,
+            &areFramesNew));
+        WriteTMXBObjectGroup(writer, t + offsetof(TmxTile, objectGroup), &tile->objectGroup);
+
+        /* Look up which image the tile's texture is so it can be set when loaded. Animations have no texture. */
+        const char* imageSource = NULL;
+        const char* documentPath = NULL;
+        for (uint32_t i = 0; tile->gid != 0 && !tile->hasAnimation && i < map->tilesetsLength; i++) {
+            const TmxTileset* tileset = &map->tilesets[i];
+            if (gid < tileset->firstGid || gid > tileset->lastGid)
+                continue;
+            documentPath = tileset->source;
+            if (tileset->hasImage)
+                imageSource = tileset->image.source;
+            for (uint32_t j = 0; imageSource == NULL && j < tileset->tilesLength; j++) {
+                if (tileset->firstGid + tileset->tiles[j].id == gid && tileset->tiles[j].hasImage)
+                    imageSource = tileset->tiles[j].image.source;
+            }
+            break;
+        }
+        WriteTMXBTexture(writer, t + offsetof(TmxTile, texture), imageSource, documentPath);
+    }
+}
+
+void FreeTMXBWriter(RaytmxTmxbWriter* writer) {
+    if (writer->data != NULL)
+        MemFree(writer->data);
+    if (writer->relocations != NULL)
+        MemFree(writer->relocations);
+    if (writer->blocks != NULL)
+        MemFree(writer->blocks);
+    for (uint32_t i = 0; i < writer->texturePathsLength; i++)
+        MemFree(writer->texturePaths[i]);
+    if (writer->texturePaths != NULL)
+        MemFree(writer->texturePaths);
+    for (uint32_t i = 0; i < writer->dependencyPathsLength; i++)
+        MemFree(writer->dependencyPaths[i]);
+    if (writer->dependencyPaths != NULL)
+        MemFree(writer->dependencyPaths);
+}
+
 #endif /* RAYTMX_IMPLEMENTATION */
 
 #endif /* RAYTMX_H */